@@ -0,0 +1,558 @@
+/* --------------------------------------------------------------------
+ *  fruitbox_bench – micro-benchmarks
+ *  – board logic: rectangle sums, applySelection, reset, move counting
+ *  – rule kernels: each preset's specialised move enumeration against
+ *    the generic sweep (Kernels.hpp)
+ *  – particles: update and vertex batch with 100k live
+ *  – persistence: round history load, indexed queries and journal
+ *    appends with a million stored rounds
+ *  – rendering (only when built with SFML): full GameScene frames into
+ *    an offscreen sf::RenderTexture, plus resize + re-layout
+ *  Every benchmark reports ns/op and heap allocations/bytes per op,
+ *  counted by the operator new hooks of AllocHooks.hpp (benchmark
+ *  thread only).
+ *  Output is JSON on stdout, or in the file given with --out.
+ *  --check-alloc runs no benchmarks: it plays steady-state GameScene
+ *  frames (a drag, moves, redeals) and exits 1 if any of them touched
+ *  the heap, 77 (skipped) if it cannot run here: no SFML, no font or
+ *  no GL context.
+ *
+ *    fruitbox_bench [--filter SUBSTR] [--min-time SEC] [--out FILE]
+ *    fruitbox_bench --check-alloc
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "core/Round.hpp"
+#include "core/Moves.hpp"
+#include "core/MoveIndex.hpp"
+#include "core/Bot.hpp"
+#include "core/Particles.hpp"
+#include "ScoreStore.hpp"
+
+#ifdef FRUITBOX_BENCH_RENDER
+#include <SFML/Graphics.hpp>
+#include "GameScene.hpp"
+#include "FrameProfiler.hpp"
+#include "ProfilerOverlay.hpp"
+#include "Resources.hpp"
+#endif
+
+/* ------------ allocation counting (benchmark thread only) ------------ */
+#include "AllocHooks.hpp"
+
+/* ------------ harness ------------------------------------------------ */
+namespace {
+
+constexpr int SKIPPED = 77;                  // exit code; CTest's SKIP_RETURN_CODE
+
+struct Sample {
+    std::string name;
+    long long   iters;
+    double      ns, allocs, bytes;
+};
+
+std::vector<Sample> results;
+std::string         filter;
+double              minTime = 0.25;          // seconds per measured batch
+volatile long long  sink    = 0;             // keeps results observable
+
+/* doubles the batch until it runs for minTime; the last batch is kept */
+template <class F>
+void bench(const std::string& name, F&& op)
+{
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    long long n = 1;
+    for (;;) {
+        AllocCount a0 = allocCount();
+        auto t0 = std::chrono::steady_clock::now();
+        for (long long i = 0; i < n; ++i) op();
+        double s = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - t0).count();
+        if (s >= minTime || n >= (1LL << 40)) {
+            AllocCount d = allocCount() - a0;
+            results.push_back({ name, n, s * 1e9 / n,
+                                double(d.allocs) / n, double(d.bytes) / n });
+            std::cerr << name << ": " << results.back().ns << " ns/op\n";
+            return;
+        }
+        long long grow = s > 0 ? (long long)(n * minTime * 1.2 / s) : n * 10;
+        n = std::max(n * 2, std::min(grow, n * 100));
+    }
+}
+
+/* the same, with setup() run before every op() outside the timed
+   region: op() is timed and its allocations counted one call at a
+   time, so keep this for ops well above the clock's own cost (~50 ns) */
+template <class S, class F>
+void bench(const std::string& name, S&& setup, F&& op)
+{
+    if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+    long long n = 1;
+    for (;;) {
+        AllocCount a;
+        std::chrono::steady_clock::duration t{};
+        for (long long i = 0; i < n; ++i) {
+            setup();
+            AllocCount a0 = allocCount();
+            auto t0 = std::chrono::steady_clock::now();
+            op();
+            t += std::chrono::steady_clock::now() - t0;
+            AllocCount d = allocCount() - a0;
+            a.allocs += d.allocs; a.bytes += d.bytes;
+        }
+        double s = std::chrono::duration<double>(t).count();
+        if (s >= minTime || n >= (1LL << 40)) {
+            results.push_back({ name, n, s * 1e9 / n,
+                                double(a.allocs) / n, double(a.bytes) / n });
+            std::cerr << name << ": " << results.back().ns << " ns/op\n";
+            return;
+        }
+        long long grow = s > 0 ? (long long)(n * minTime * 1.2 / s) : n * 10;
+        n = std::max(n * 2, std::min(grow, n * 100));
+    }
+}
+
+void writeJson(std::ostream& o)
+{
+    o << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Sample& s = results[i];
+        o << "    { \"name\": \"" << s.name << "\", \"iterations\": " << s.iters
+          << ", \"ns_per_op\": " << s.ns
+          << ", \"allocs_per_op\": " << s.allocs
+          << ", \"bytes_per_op\": " << s.bytes << " }"
+          << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    o << "  ]\n}\n";
+}
+
+/* ------------ board logic -------------------------------------------- */
+void benchBoard()
+{
+    Round round(1);
+
+    std::vector<Rect> rects;
+    std::uint64_t x = 7;
+    for (int i = 0; i < 1024; ++i) {
+        auto rnd = [&](int n) { return int(BoardGen::splitmix(x) % std::uint64_t(n)); };
+        rects.push_back(Rect::span(rnd(Round::ROWS), rnd(Round::COLS),
+                                   rnd(Round::ROWS), rnd(Round::COLS)));
+    }
+    std::size_t k = 0;
+    bench("board/sum", [&] { sink += round.sum(rects[k++ & 1023]); });
+
+    /* a full greedy game, replayed move by move; the start position is
+       restored by copy-assignment, which reuses the board's storage    */
+    std::vector<Rect> line;
+    { Round g(1); Rect m; while (greedyMove(g, m)) { g.apply(m); line.push_back(m); } }
+    const Round start(1);
+    Round play = start;
+    k = 0;
+    bench("board/applySelection", [&] {
+        if (k == line.size()) { play = start; k = 0; }
+        sink += play.apply(line[k++]);
+    });
+
+    std::uint64_t seed = 1;
+    bench("board/reset", [&] { round.reset(seed++); sink += round.board().total(); });
+
+    seed = 1;
+    Board b(Round::ROWS, Round::COLS);
+    bench("board/countMoves", [&] { BoardGen::fill(b, seed++); sink += countMoves(b); });
+
+    /* marathon board: sums stay four lookups however large the rectangle */
+    Round big(1, Round::MAX_SIDE, Round::MAX_SIDE);
+    rects.clear();
+    for (int i = 0; i < 1024; ++i) {
+        auto rnd = [&](int n) { return int(BoardGen::splitmix(x) % std::uint64_t(n)); };
+        rects.push_back(Rect::span(rnd(big.rows()), rnd(big.cols()),
+                                   rnd(big.rows()), rnd(big.cols())));
+    }
+    k = 0;
+    bench("board/sum-1000x1000", [&] { sink += big.sum(rects[k++ & 1023]); });
+
+    /* move index: full build, then the incremental update along the
+       greedy line; the move itself is applied (and restarts restore
+       both by copy-assignment) outside the timed region                */
+    MoveIndex startIdx;
+    startIdx.build(start.board());
+    MoveIndex idx;
+    bench("moves/build", [&] { idx.build(start.board()); sink += idx.count(); });
+
+    std::vector<int> cleared;
+    play = start;
+    idx  = startIdx;
+    k = 0;
+    bench("moves/update", [&] {
+        if (k == line.size()) { play = start; idx = startIdx; k = 0; }
+        play.apply(line[k++], &cleared);
+    }, [&] {
+        idx.update(play.board(), cleared);
+        sink += idx.count();
+    });
+
+    /* marathon: the board's own moves in scan order, skipping any that an
+       earlier one broke; long enough that the timed loop never restarts  */
+    std::vector<Rect> bigLine;
+    {
+        Round g = big;
+        std::vector<Rect> all;
+        validMoves(g.board(), all);
+        for (const Rect& m : all)
+            if (g.sum(m) == Round::TARGET && tight(g.board(), m) && g.apply(m))
+                bigLine.push_back(m);
+    }
+    MoveIndex bigIdx;
+    bigIdx.build(big.board());
+    k = 0;
+    bench("moves/update-1000x1000", [&] {
+        if (k == bigLine.size()) cleared.clear();
+        else big.apply(bigLine[k++], &cleared);
+    }, [&] {
+        bigIdx.update(big.board(), cleared);
+        sink += bigIdx.count();
+    });
+}
+
+/* ------------ rule kernels ------------------------------------------- */
+/* each preset's kernel against the generic sweep on the same 64 fresh
+   boards                                                              */
+template <class P>
+void benchPreset(const std::string& name)
+{
+    std::vector<Board> boards(64, Board(P::ROWS, P::COLS));
+    for (std::size_t i = 0; i < boards.size(); ++i)
+        BoardGen::fill(boards[i], i + 1, P::LO, P::HI);
+
+    std::size_t k = 0;
+    bench("rules/moves-" + name + "-kernel", [&] {
+        int n = 0;
+        MoveKernel<P>::forEachMove(boards[k++ & 63], [&](const Rect&) { ++n; });
+        sink += n;
+    });
+    k = 0;
+    bench("rules/moves-" + name + "-generic", [&] {
+        int n = 0;
+        forEachMoveGeneric(boards[k++ & 63], P::TARGET, [&](const Rect&) { ++n; });
+        sink += n;
+    });
+}
+
+void benchRules()
+{
+    benchPreset<Classic>("classic");
+    benchPreset<Fives>("fives");
+    benchPreset<Twenties>("twenties");
+}
+
+/* ------------ particles ---------------------------------------------- */
+/* 100k live particles (a 144 Hz frame has 6.9 ms): the update pass and
+   the vertex batch, into a stand-in with sf::Vertex's layout          */
+void benchParticles()
+{
+    struct Vertex {
+        struct { float x, y; }                position;
+        struct { std::uint8_t r, g, b, a; }   color;
+        struct { float x, y; }                texCoords;
+    };
+    const std::size_t N = 100000;
+    Particles p;
+    for (std::size_t i = 0; i < N; ++i)             // never expire while measured
+        p.add(float(i % 1000), float(i / 1000), 1.f, -5.f, 1e9f, 0.1f, 0.5f, 255, 200, 60);
+    bench("particles/update-100k", [&] { p.update(1.f / 144.f); sink += (long long)p.size(); });
+
+    std::vector<Vertex> verts(N * 4);
+    bench("particles/quads-100k", [&] { p.quads(verts.data()); sink += verts[0].color.a; });
+
+    /* steady churn: one classic board's worth of clears per frame */
+    Particles q;
+    int cell = 0;
+    bench("particles/burst+update", [&] {
+        for (int k = 0; k < 10; ++k, ++cell) q.burst(cell / 17 % 10, cell % 17);
+        q.update(1.f / 144.f);
+        sink += (long long)q.size();
+    });
+}
+
+/* ------------ persistence -------------------------------------------- */
+void benchHistory()
+{
+    fs::path dir = fs::temp_directory_path() / "fruitbox_bench";
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+
+    /* a million rounds over ~3 years, in one bulk block */
+    const std::size_t N = 1000000;
+    std::vector<RoundRecord> v(N);
+    std::uint64_t x = 3;
+    for (RoundRecord& r : v) {
+        r.seed       = BoardGen::splitmix(x) % 200000;      // boards get replayed
+        r.score      = int(BoardGen::splitmix(x) % 90);
+        r.moves      = r.score;
+        r.durationMs = 120000;
+        r.time       = 1700000000 + std::int64_t(BoardGen::splitmix(x) % (3 * 365 * 86400));
+    }
+    { ScoreStore s(dir); s.addBulk(v); }
+
+    bench("history/load-1M", [&] { ScoreStore s(dir); sink += (long long)s.size(); });
+
+    ScoreStore s(dir);
+    bench("history/top100", [&] { sink += s.top(100)[0]; });
+    std::int32_t day = ScoreStore::dayOf(v[0].time);
+    bench("history/topOnDay100", [&] { sink += s.topOnDay(day, 100)[0]; });
+    std::uint64_t q = 0;
+    bench("history/bestForSeed", [&] {
+        RoundRecord r;
+        sink += s.bestForSeed(q++ % 200000, r) ? r.score : 0;
+    });
+
+    /* one durable journal append (includes fsync) */
+    bench("history/add", [&] { s.add(v[std::size_t(q++ % N)]); });
+
+    fs::remove_all(dir, ec);
+}
+
+/* ------------ rendering ---------------------------------------------- */
+#ifdef FRUITBOX_BENCH_RENDER
+bool loadFont(sf::Font& font)
+{
+    Resource ttf = resource("arial.ttf");
+    return ttf.data && font.loadFromMemory(ttf.data, ttf.size);
+}
+
+void benchRender()
+{
+    sf::Font font;
+    if (!loadFont(font)) {
+        std::cerr << "render benchmarks skipped: no font\n";
+        return;
+    }
+
+    InputBindings binds;
+    Settings      set;                           // history in memory only
+    BoardPool     pool(1);
+    set.showFPS = true;
+
+    const sf::Vector2u sizes[] = { { 800, 600 }, { 1920, 1080 }, { 3840, 2160 } };
+    for (sf::Vector2u sz : sizes) {
+        sf::RenderTexture rt;
+        if (!rt.create(sz.x, sz.y)) {
+            std::cerr << "render benchmarks skipped: no GL context\n";
+            return;
+        }
+        std::string tag = std::to_string(sz.x) + "x" + std::to_string(sz.y);
+
+        GameScene scene(font, binds, set, pool, sz);
+        bench("render/frame-" + tag, [&] {
+            scene.publish();
+            rt.clear(sf::Color::Black);
+            scene.draw(rt);
+            rt.display();
+        });
+
+        /* alternate between two sizes: camera re-fit, atlas re-bake and
+           a full geometry rebuild on every frame                          */
+        sf::Event ev;
+        ev.type = sf::Event::Resized;
+        bool big = false;
+        bench("render/resize-" + tag, [&] {
+            big = !big;
+            ev.size.width  = big ? sz.x : sz.x * 3 / 4;
+            ev.size.height = big ? sz.y : sz.y * 3 / 4;
+            scene.handleEvent(ev);
+            scene.publish();
+            rt.clear(sf::Color::Black);
+            scene.draw(rt);
+            rt.display();
+        });
+    }
+
+    /* marathon board at 1920x1080: whole board (overview texture),
+       zoomed to ~60 px cells (cached chunks), and panning across it     */
+    sf::RenderTexture rt;
+    if (!rt.create(1920, 1080)) return;
+    set.rules = Classic::RULES.sized(Round::MAX_SIDE, Round::MAX_SIDE);
+    GameScene big(font, binds, set, pool, { 1920, 1080 });
+    auto frame = [&] { big.publish(); rt.clear(sf::Color::Black); big.draw(rt); rt.display(); };
+    bench("render/marathon-fit", frame);
+
+    sf::Event ev;
+    ev.type = sf::Event::MouseWheelScrolled;
+    ev.mouseWheelScroll.wheel = sf::Mouse::VerticalWheel;
+    ev.mouseWheelScroll.delta = 1.f;
+    ev.mouseWheelScroll.x = 960;
+    ev.mouseWheelScroll.y = 540;
+    for (int i = 0; i < 18; ++i) big.handleEvent(ev);
+    bench("render/marathon-zoomed", frame);
+
+    ev.type = sf::Event::MouseButtonPressed;
+    ev.mouseButton.button = sf::Mouse::Right;
+    ev.mouseButton.x = 960;
+    ev.mouseButton.y = 540;
+    big.handleEvent(ev);
+    ev.type = sf::Event::MouseMoved;
+    ev.mouseMove.x = 960;
+    ev.mouseMove.y = 540;
+    int step = 0;
+    bench("render/marathon-pan", [&] {
+        ev.mouseMove.x += (step++ / 512) % 2 ? 24 : -24;   // ~200 cells each way
+        big.handleEvent(ev);
+        frame();
+    });
+    set.rules = Classic::RULES;
+}
+
+/* ------------ zero-allocation check ---------------------------------- */
+/* Steady state: the clock runs, a selection is being dragged, a hint is
+   shown, FPS counter and profiler overlay are on. Every RELEASE frames
+   the drag ends and the hinted move is played – move index update,
+   particle burst, hint reset, change log – and a board with no move
+   left is redealt. Every phase of every measured frame must leave the
+   heap alone; warm-up frames may not (glyph pages, vertex arrays and
+   strings grow to size there).
+   Returns the number of frames that allocated, or -1 if the check
+   cannot run.                                                         */
+int checkAlloc()
+{
+    sf::Font font;
+    sf::RenderTexture rt;
+    if (!loadFont(font) || !rt.create(1024, 768)) {
+        std::cerr << "alloc check skipped: no font or no GL context\n";
+        return -1;
+    }
+    InputBindings   binds;
+    Settings        set;
+    BoardPool       pool(1);
+    FrameProfiler   prof;
+    ProfilerOverlay overlay;
+    set.showFPS = set.showProfiler = true;
+    GameScene scene(font, binds, set, pool, { 1024, 768 });
+
+    auto key = [&](sf::Keyboard::Key k) {
+        sf::Event e;
+        e.type = sf::Event::KeyPressed;
+        e.key.code = k;
+        scene.handleEvent(e);
+    };
+    auto mouse = [&](sf::Event::EventType type, sf::Vector2f p) {
+        sf::Event e;
+        e.type = type;
+        if (type == sf::Event::MouseMoved) { e.mouseMove.x = int(p.x); e.mouseMove.y = int(p.y); }
+        else {
+            e.mouseButton.button = sf::Mouse::Left;
+            e.mouseButton.x = int(p.x);
+            e.mouseButton.y = int(p.y);
+        }
+        scene.handleEvent(e);
+    };
+    auto cell = [&](int r, int c) { return scene.worldToWin({ c + 0.5f, r + 0.5f }); };
+    const sf::Vector2f from(100.f, 150.f);      // cell (1, 1) of the fitted board
+
+    /* end the drag (it may clear something by chance), play the hint,
+       redeal if that was the last move, then hint and drag again      */
+    auto play = [&] {
+        mouse(sf::Event::MouseButtonReleased, from);
+        Rect m;
+        if (scene.moves().hint(m)) {
+            mouse(sf::Event::MouseButtonPressed,  cell(m.r1, m.c1));
+            mouse(sf::Event::MouseMoved,          cell(m.r2, m.c2));
+            mouse(sf::Event::MouseButtonReleased, cell(m.r2, m.c2));
+        }
+        while (!scene.moves().count()) key(binds.restart);
+        key(binds.hint);
+        mouse(sf::Event::MouseButtonPressed, from);
+    };
+    key(binds.hint);
+    mouse(sf::Event::MouseButtonPressed, from);
+
+    const int WARMUP = 120, FRAMES = 600;       // 12 s of play at 60 Hz
+    const int RELEASE = 6;                      // a move every 0.1 s
+    int bad = 0;
+    for (int i = 0; i < WARMUP + FRAMES; ++i) {
+        prof.beginFrame();
+        if (i % RELEASE == RELEASE - 1) play();
+        mouse(sf::Event::MouseMoved, { i % 2 ? 400.f : 600.f, 400.f });   // a new selection
+        prof.mark(FrameProfiler::Events);
+        scene.update(1.f / 60.f);
+        scene.publish();
+        prof.mark(FrameProfiler::Update);
+        rt.clear(sf::Color::Black);
+        scene.draw(rt);
+        overlay.draw(rt, font, prof);
+        prof.mark(FrameProfiler::Draw);
+        rt.display();
+        prof.mark(FrameProfiler::Present);
+        prof.endFrame();
+
+        const FrameProfiler::Frame& f = prof.recent(0);
+        if (i < WARMUP) continue;
+        std::int64_t bytes = 0, allocs = 0;
+        for (int p = 0; p < FrameProfiler::PhaseCount; ++p) {
+            bytes  += f.bytes[p];
+            allocs += f.allocs[p];
+        }
+        if (!bytes && !allocs) continue;
+        if (++bad <= 10) {
+            std::cerr << "frame " << i - WARMUP << " allocated:";
+            for (int p = 0; p < FrameProfiler::PhaseCount; ++p)
+                std::cerr << ' ' << FrameProfiler::phaseName(p) << ' ' << f.allocs[p];
+            std::cerr << " (" << bytes << " B)\n";
+        }
+    }
+    std::cerr << "alloc check: " << bad << " of " << FRAMES << " frames allocated\n";
+    return bad;
+}
+#endif
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string out;
+    bool checkOnly = false;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+        if      (!std::strcmp(a, "--filter")   && v) { filter  = v; ++i; }
+        else if (!std::strcmp(a, "--min-time") && v) { minTime = std::atof(v); ++i; }
+        else if (!std::strcmp(a, "--out")      && v) { out     = v; ++i; }
+        else if (!std::strcmp(a, "--check-alloc"))     checkOnly = true;
+        else {
+            std::cerr << "usage: fruitbox_bench [--filter SUBSTR] [--min-time SEC] [--out FILE]\n"
+                         "       fruitbox_bench --check-alloc\n";
+            return 2;
+        }
+    }
+
+    if (checkOnly) {
+#ifdef FRUITBOX_BENCH_RENDER
+        int bad = checkAlloc();
+        return bad < 0 ? SKIPPED : bad ? 1 : 0;
+#else
+        std::cerr << "alloc check skipped: built without SFML\n";
+        return SKIPPED;
+#endif
+    }
+
+    benchBoard();
+    benchRules();
+    benchParticles();
+    benchHistory();
+#ifdef FRUITBOX_BENCH_RENDER
+    benchRender();
+#endif
+
+    if (out.empty()) writeJson(std::cout);
+    else { std::ofstream f(out); writeJson(f); }
+}
@@ -0,0 +1,36 @@
+# ----------------------------------------------------------------------
+#  Turns files into byte arrays in one C++ source (see src/Resources.hpp)
+#    cmake -DOUT=Resources.cpp -DROOT=<dir> -DFILES="a.ttf;b.png" -P EmbedResources.cmake
+#  Names are the paths relative to ROOT.
+# ----------------------------------------------------------------------
+# CMake regexes have no {n}: spell out one line of 20 bytes
+string(REPEAT "0x..," 20 line)
+
+set(body "")
+set(table "")
+set(i 0)
+foreach(name IN LISTS FILES)
+  file(READ "${ROOT}/${name}" hex HEX)
+  file(SIZE "${ROOT}/${name}" size)
+  string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," hex "${hex}")
+  string(REGEX REPLACE "(${line})" "\\1\n    " hex "${hex}")
+  string(APPEND body "static const unsigned char res${i}[] = {\n    ${hex}0 };\n\n")
+  string(APPEND table "    { \"${name}\", res${i}, ${size}u },\n")
+  math(EXPR i "${i} + 1")
+endforeach()
+
+set(src "// generated by cmake/EmbedResources.cmake - do not edit\n")
+string(APPEND src "#include <cstring>\n#include \"Resources.hpp\"\n\n${body}")
+string(APPEND src "static const struct { const char* name; const unsigned char* data; std::size_t size; } table[] = {\n${table}};\n\n")
+string(APPEND src "Resource resource(const char* name)\n{\n")
+string(APPEND src "    for (const auto& r : table)\n")
+string(APPEND src "        if (!std::strcmp(r.name, name)) return { r.data, r.size };\n")
+string(APPEND src "    return { nullptr, 0 };\n}\n")
+
+# rewrite only on change, so dependants are not rebuilt needlessly
+if(EXISTS "${OUT}")
+  file(READ "${OUT}" old)
+endif()
+if(NOT old STREQUAL src)
+  file(WRITE "${OUT}" "${src}")
+endif()
@@ -0,0 +1,22 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Heap allocation counters
+ *  – per thread: calls to the global operator new made by the calling
+ *    thread and the bytes they asked for, since the thread started
+ *  – counted only in binaries that compile in the hooks (AllocHooks.hpp):
+ *    the bench always, the game when built with FRUITBOX_TRACK_ALLOCS;
+ *    everywhere else the counters stay at zero
+ * ------------------------------------------------------------------ */
+#include <cstdint>
+
+struct AllocCount {
+    std::int64_t allocs = 0;
+    std::int64_t bytes  = 0;
+
+    AllocCount operator-(const AllocCount& o) const
+    { return { allocs - o.allocs, bytes - o.bytes }; }
+};
+
+inline thread_local AllocCount tAllocCount;
+
+inline AllocCount allocCount() { return tAllocCount; }
@@ -0,0 +1,40 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Replacement global operator new / delete that feed AllocCount.hpp
+ *  – include from exactly one translation unit of a binary (they are
+ *    definitions, not declarations)
+ *  – malloc / free underneath; over-aligned new is left to the library
+ *    and not counted
+ * ------------------------------------------------------------------ */
+#include <cstdlib>
+#include <new>
+
+#include "AllocCount.hpp"
+
+void* operator new(std::size_t n)
+{
+    ++tAllocCount.allocs; tAllocCount.bytes += std::int64_t(n);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t n)                    { return operator new(n); }
+void* operator new(std::size_t n, const std::nothrow_t&) noexcept
+{
+    ++tAllocCount.allocs; tAllocCount.bytes += std::int64_t(n);
+    return std::malloc(n ? n : 1);
+}
+void* operator new[](std::size_t n, const std::nothrow_t& t) noexcept
+{ return operator new(n, t); }
+/* GCC sees free() on a pointer from operator new; these hooks are that
+   operator new, and it returns malloc'ed memory                       */
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void  operator delete(void* p) noexcept                { std::free(p); }
+void  operator delete[](void* p) noexcept              { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept   { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#  pragma GCC diagnostic pop
+#endif
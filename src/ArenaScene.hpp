@@ -0,0 +1,224 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Arena scene: a grid of classic boards played live by the greedy bot
+ *  (core/Arena.hpp), for demos and soak tests
+ *  – simulation runs on the arena's worker pool; this scene only
+ *    hands due boards back to it and reads the latest snapshots, which
+ *    never waits, so the frame rate does not depend on the bots
+ *  – every board has fixed slots in two vertex arrays (tiles, digits
+ *    textured straight from the font's glyph page); a board's slots
+ *    are rewritten only when its snapshot version moved
+ *  – Space: Watch ↔ FlatOut; B: 16 / 36 / 64 boards; Esc: menu
+ *  – HUD: boards, worker threads, moves/s and rounds/s over all boards
+ *  Boards use the game's tile colours (BoardRenderer::tileColor); the
+ *  cells of each board's last move are lit until its next one.
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "Scene.hpp"
+#include "BoardRenderer.hpp"
+#include "LiveText.hpp"
+#include "core/Arena.hpp"
+
+class ArenaScene : public Scene {
+    static constexpr int   CELLS  = Round::ROWS * Round::COLS;
+    static constexpr float HUD_PX = 40.f;            // band above the grid
+
+    sf::Font&              font_;
+    const std::uint64_t    entropy_;
+    SceneID                next_ = SceneID::None;
+
+    std::unique_ptr<Arena> arena_;
+    int                    count_ = 36;            // boards
+
+    /* ------------ layout ------------------------------------------ */
+    sf::Vector2f           win_;
+    float                  cell_ = 0.f;            // px per cell
+    std::vector<sf::Vector2f> origin_;             // top-left of each board
+    unsigned               charSize_ = 0;          // digits; 0 = too small to read
+    sf::Glyph              glyph_[10];             // digits 1-9 at charSize_
+    bool                   warmed_ = false;        // glyph_ and captions rasterised
+
+    /* ------------ drawing ----------------------------------------- */
+    sf::VertexArray        tiles_  { sf::Quads };
+    sf::VertexArray        digits_ { sf::Quads };
+    std::vector<std::uint64_t> drawn_;             // snapshot version in the arrays
+    std::vector<LiveText>  captions_;
+    LiveText               hud_;
+
+    /* ------------ rates ------------------------------------------- */
+    float                  sinceRate_ = 0.f;
+    std::uint64_t          lastMoves_ = 0, lastRounds_ = 0;
+    float                  movesPerSec_ = 0.f, roundsPerSec_ = 0.f;
+
+    void start(int boards, Arena::Pace pace)
+    {
+        arena_.reset();                            // join the old workers first
+        count_ = boards;
+        arena_ = std::make_unique<Arena>(count_, entropy_, pace);
+        lastMoves_  = arena_->moves();
+        lastRounds_ = arena_->rounds();
+        sinceRate_  = 0.f;
+        layout();
+    }
+
+    /* grid with the most px per cell that fits the window */
+    void layout()
+    {
+        const float bw = Round::COLS + 1.f, bh = Round::ROWS + 2.5f;   // + margin, caption
+        int best = 1;
+        cell_ = 0.f;
+        for (int g = 1; g <= count_; ++g) {
+            int rows = (count_ + g - 1) / g;
+            float c = std::min(win_.x / (g * bw), (win_.y - HUD_PX) / (rows * bh));
+            if (c > cell_) { cell_ = c; best = g; }
+        }
+        int rows = (count_ + best - 1) / best;
+        float x0 = (win_.x - best * bw * cell_) / 2.f + cell_ / 2.f;
+        float y0 = HUD_PX + (win_.y - HUD_PX - rows * bh * cell_) / 2.f + cell_ / 2.f;
+        origin_.resize(std::size_t(count_));
+        for (int i = 0; i < count_; ++i)
+            origin_[std::size_t(i)] = { x0 + (i % best) * bw * cell_, y0 + (i / best) * bh * cell_ };
+
+        charSize_ = cell_ >= 12.f ? unsigned(cell_ * 0.6f) : 0u;
+
+        tiles_.resize(std::size_t(count_) * CELLS * 4);
+        digits_.resize(std::size_t(count_) * CELLS * 4);
+        drawn_.assign(std::size_t(count_), ~0ull);   // everything is stale
+
+        captions_.resize(std::size_t(count_));
+        for (int i = 0; i < count_; ++i) {
+            LiveText& t = captions_[std::size_t(i)];
+            t.setFont(font_);
+            t.setCharacterSize(unsigned(std::max(10.f, cell_ * 0.9f)));
+            t.setPosition(origin_[std::size_t(i)].x,
+                          origin_[std::size_t(i)].y + Round::ROWS * cell_ + cell_ * 0.2f);
+        }
+        warmed_ = false;
+        dirty_  = true;
+    }
+
+    /* glyphs for the current layout, on the first draw after it */
+    void warm()
+    {
+        for (int d = 1; d <= 9 && charSize_; ++d)
+            glyph_[d] = font_.getGlyph(sf::Uint32('0' + d), charSize_, false);
+        for (const LiveText& t : captions_) t.prewarm("0123456789#:final ");
+        hud_.prewarm("0123456789.");
+        warmed_ = true;
+    }
+
+    /* rewrite board i's slots from its snapshot */
+    void paint(int i, const Arena::View& v)
+    {
+        static const sf::Color lit(230, 200, 90);
+        const float gap = std::max(1.f, cell_ / 24.f);
+        sf::Vertex* t = &tiles_[std::size_t(i) * CELLS * 4];
+        sf::Vertex* d = &digits_[std::size_t(i) * CELLS * 4];
+        sf::Vector2f o = origin_[std::size_t(i)];
+        for (int r = 0; r < Round::ROWS; ++r)
+            for (int c = 0; c < Round::COLS; ++c, t += 4, d += 4) {
+                int   val = v.cells[r * Round::COLS + c];
+                float l = o.x + c * cell_, top = o.y + r * cell_;
+                bool  justCleared = !val && r >= v.last.r1 && r <= v.last.r2 &&
+                                    c >= v.last.c1 && c <= v.last.c2;
+                sf::Color col = justCleared ? lit : BoardRenderer::tileColor(val != 0);
+                t[0] = { { l, top }, col };
+                t[1] = { { l + cell_ - gap, top }, col };
+                t[2] = { { l + cell_ - gap, top + cell_ - gap }, col };
+                t[3] = { { l, top + cell_ - gap }, col };
+
+                if (!val || !charSize_) {          // degenerate: nothing drawn
+                    for (int k = 0; k < 4; ++k) d[k] = { { l, top }, sf::Color::Transparent };
+                    continue;
+                }
+                const sf::Glyph& g = glyph_[val];
+                float gl = l + (cell_ - gap - g.bounds.width) / 2.f;
+                float gt = top + (cell_ - gap - g.bounds.height) / 2.f;
+                float u = float(g.textureRect.left), w = float(g.textureRect.width);
+                float vv = float(g.textureRect.top), h = float(g.textureRect.height);
+                d[0] = { { gl, gt },                                   { u,     vv     } };
+                d[1] = { { gl + g.bounds.width, gt },                  { u + w, vv     } };
+                d[2] = { { gl + g.bounds.width, gt + g.bounds.height }, { u + w, vv + h } };
+                d[3] = { { gl, gt + g.bounds.height },                  { u,     vv + h } };
+            }
+
+        int secs = v.ticksLeft / Round::TICK_HZ;
+        if (v.over) captions_[std::size_t(i)].set("#%u  final %d", v.round, v.score);
+        else        captions_[std::size_t(i)].set("#%u  %d   %d:%02d", v.round, v.score,
+                                                  secs / 60, secs % 60);
+    }
+
+public:
+    ArenaScene(sf::Font& f, sf::Vector2u size, std::uint64_t entropy)
+        : font_(f), entropy_(entropy),
+          win_(float(size.x), float(size.y)),
+          hud_(f, 20)
+    {
+        hud_.setPosition(10.f, 10.f);
+        start(count_, Arena::Pace::Watch);
+    }
+
+    void handleEvent(const sf::Event& e) override
+    {
+        if (e.type == sf::Event::Resized) {
+            win_ = { float(e.size.width), float(e.size.height) };
+            layout();
+        }
+        if (e.type != sf::Event::KeyPressed) return;
+        if (e.key.code == sf::Keyboard::Escape) next_ = SceneID::Menu;
+        else if (e.key.code == sf::Keyboard::Space)
+            arena_->setPace(arena_->pace() == Arena::Pace::Watch ? Arena::Pace::FlatOut
+                                                                 : Arena::Pace::Watch);
+        else if (e.key.code == sf::Keyboard::B)
+            start(count_ == 16 ? 36 : count_ == 36 ? 64 : 16, arena_->pace());
+    }
+
+    void update(float dt) override
+    {
+        arena_->pump();
+
+        sinceRate_ += dt;
+        if (sinceRate_ >= 0.5f) {
+            std::uint64_t m = arena_->moves(), r = arena_->rounds();
+            movesPerSec_  = float(m - lastMoves_)  / sinceRate_;
+            roundsPerSec_ = float(r - lastRounds_) / sinceRate_;
+            lastMoves_ = m; lastRounds_ = r;
+            sinceRate_ = 0.f;
+        }
+        dirty_ = true;
+    }
+
+    float wakeAfter() const override { return 0.f; }   // live: the boards move on their own
+
+    void draw(sf::RenderTarget& w) override
+    {
+        w.setView(sf::View(sf::FloatRect(0.f, 0.f, win_.x, win_.y)));
+        if (!warmed_) warm();
+        for (int i = 0; i < count_; ++i)
+            arena_->read(i, [&](const Arena::View& v) {
+                if (v.version != drawn_[std::size_t(i)]) {
+                    paint(i, v);
+                    drawn_[std::size_t(i)] = v.version;
+                }
+            });
+
+        w.draw(tiles_);
+        if (charSize_) w.draw(digits_, sf::RenderStates(&font_.getTexture(charSize_)));
+        for (const LiveText& t : captions_) w.draw(t);
+
+        hud_.set("%d boards on %d threads   %s   %.0f moves/s   %.1f rounds/s"
+                 "      [Space] pace  [B] boards  [Esc] menu",
+                 count_, arena_->threads(),
+                 arena_->pace() == Arena::Pace::Watch ? "watch" : "flat out",
+                 double(movesPerSec_), double(roundsPerSec_));
+        w.draw(hud_);
+    }
+
+    SceneID next() const override { return next_; }
+    void    resetNext()  override { next_ = SceneID::None; }
+};
@@ -0,0 +1,237 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Chunked board renderer, in world units of one cell
+ *  – the board is cut into CHUNK×CHUNK chunks; each keeps its own tile
+ *    quads (untextured) and digit quads (textured from the atlas) and
+ *    is rebuilt only when a cell inside it changed
+ *  – only chunks that intersect the target's view are built and
+ *    drawn; chunks that scrolled out are freed once the cache exceeds
+ *    BUDGET, so memory and frame time follow what is visible, not the
+ *    board size
+ *  – the atlas (digits 1-9 side by side) is baked at the on-screen
+ *    cell size rounded up to 8 px, so zooming re-bakes only now and then
+ *  – zoomed out below DETAIL_PX per cell, digits are unreadable: the
+ *    whole board is one quad sampling an overview texture with one
+ *    texel per cell, patched in place when cells are cleared
+ *  – the atlas and the overview texture are created on first use:
+ *    SFML opens its GL context as soon as any texture is constructed,
+ *    and a headless replay builds this renderer but never draws
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/Board.hpp"
+
+class BoardRenderer {
+public:
+    static constexpr int         CHUNK     = 32;      // cells per chunk side
+    static constexpr float       DETAIL_PX = 16.f;    // below: overview texture
+    static constexpr std::size_t BUDGET    = 256;     // chunks kept built
+
+private:
+    struct Chunk {
+        sf::VertexArray tiles  { sf::Quads };
+        sf::VertexArray digits { sf::Quads };
+        bool            built = false;
+        bool            dirty = true;
+        std::uint64_t   seen  = 0;                    // frame last drawn
+    };
+
+    std::unique_ptr<sf::RenderTexture> atlas_;        // 9 glyph slots, 1 row
+    unsigned           slot_  = 0;                    // slot side in px (0 = none)
+
+    int                rows_ = 0, cols_ = 0;          // board size in cells
+    int                crows_ = 0, ccols_ = 0;        // ... in chunks
+    std::vector<Chunk> chunks_;
+    std::size_t        built_ = 0;
+    std::uint64_t      frame_ = 0;
+
+    std::unique_ptr<sf::Texture> overview_;           // one texel per cell
+    std::vector<sf::Uint8>     texels_;               // scratch for uploads
+    bool                       ovStale_ = true;       // needs a full upload
+    int                        ovR1_ = 1, ovC1_ = 1, ovR2_ = 0, ovC2_ = 0;   // pending patch
+    sf::VertexArray            ovQuad_ { sf::Quads, 4 };
+
+    static void quad(sf::VertexArray& va, float l, float t, float r, float b,
+                     sf::Color col)
+    {
+        va.append({ { l, t }, col });
+        va.append({ { r, t }, col });
+        va.append({ { r, b }, col });
+        va.append({ { l, b }, col });
+    }
+
+    static void quad(sf::VertexArray& va, float l, float t, float r, float b,
+                     float u, float uvSize)
+    {
+        va.append({ { l, t }, { u,          0.f    } });
+        va.append({ { r, t }, { u + uvSize, 0.f    } });
+        va.append({ { r, b }, { u + uvSize, uvSize } });
+        va.append({ { l, b }, { u,          uvSize } });
+    }
+
+    void build(Chunk& ch, const Board& board, int cr, int cc)
+    {
+        ch.tiles.clear();
+        ch.digits.clear();
+        const float gap = 1.f / 48.f;                 // ~1 px at classic size
+        const float s   = float(slot_);
+        int r0 = cr * CHUNK, r1 = std::min(rows_, r0 + CHUNK);
+        int c0 = cc * CHUNK, c1 = std::min(cols_, c0 + CHUNK);
+        for (int r = r0; r < r1; ++r)
+            for (int c = c0; c < c1; ++c) {
+                bool on = board.alive(r, c);
+                quad(ch.tiles, float(c), float(r), c + 1 - gap, r + 1 - gap, tileColor(on));
+                if (on && slot_)
+                    quad(ch.digits, float(c), float(r), c + 1.f, r + 1.f,
+                         (board.value(r, c) - 1) * s, s);
+            }
+        if (!ch.built) ++built_;
+        ch.built = true;
+        ch.dirty = false;
+    }
+
+    void release(Chunk& ch)
+    {
+        ch.tiles  = sf::VertexArray(sf::Quads);       // give the memory back
+        ch.digits = sf::VertexArray(sf::Quads);
+        ch.built  = false;
+        ch.dirty  = true;
+        --built_;
+    }
+
+    void uploadOverview(const Board& board)
+    {
+        if (ovStale_) {
+            if (!overview_) overview_ = std::make_unique<sf::Texture>();
+            if (overview_->getSize() != sf::Vector2u(unsigned(cols_), unsigned(rows_)) &&
+                !overview_->create(unsigned(cols_), unsigned(rows_)))
+                return;
+            ovR1_ = 0; ovC1_ = 0; ovR2_ = rows_ - 1; ovC2_ = cols_ - 1;
+            ovStale_ = false;
+        }
+        if (ovR1_ > ovR2_) return;
+        int w = ovC2_ - ovC1_ + 1, h = ovR2_ - ovR1_ + 1;
+        texels_.resize(std::size_t(w) * h * 4);
+        sf::Uint8* p = texels_.data();
+        for (int r = ovR1_; r <= ovR2_; ++r)
+            for (int c = ovC1_; c <= ovC2_; ++c, p += 4) {
+                const sf::Color& col = tileColor(board.alive(r, c));
+                p[0] = col.r; p[1] = col.g; p[2] = col.b; p[3] = 255;
+            }
+        overview_->update(texels_.data(), unsigned(w), unsigned(h),
+                         unsigned(ovC1_), unsigned(ovR1_));
+        ovR1_ = ovC1_ = 1; ovR2_ = ovC2_ = 0;         // nothing pending
+    }
+
+public:
+    static const sf::Color& tileColor(bool alive)
+    {
+        static const sf::Color live(200, 80, 80), dead(40, 40, 40);
+        return alive ? live : dead;
+    }
+
+    /* a new board (or one of another size): everything is stale */
+    void reset(const Board& board)
+    {
+        rows_  = board.rows();
+        cols_  = board.cols();
+        crows_ = (rows_ + CHUNK - 1) / CHUNK;
+        ccols_ = (cols_ + CHUNK - 1) / CHUNK;
+        if (chunks_.size() == std::size_t(crows_) * ccols_)
+            for (Chunk& ch : chunks_) ch.dirty = true;    // same grid: keep the arrays
+        else {
+            chunks_.clear();
+            chunks_.resize(std::size_t(crows_) * ccols_);
+            built_ = 0;
+        }
+        ovStale_ = true;
+    }
+
+    /* cells in [r1,r2]×[c1,c2] changed */
+    void invalidate(int r1, int c1, int r2, int c2)
+    {
+        for (int cr = r1 / CHUNK; cr <= r2 / CHUNK; ++cr)
+            for (int cc = c1 / CHUNK; cc <= c2 / CHUNK; ++cc)
+                chunks_[std::size_t(cr) * ccols_ + cc].dirty = true;
+        if (ovR1_ > ovR2_) { ovR1_ = r1; ovC1_ = c1; ovR2_ = r2; ovC2_ = c2; }
+        else {
+            ovR1_ = std::min(ovR1_, r1); ovC1_ = std::min(ovC1_, c1);
+            ovR2_ = std::max(ovR2_, r2); ovC2_ = std::max(ovC2_, c2);
+        }
+    }
+
+    /* bake digits 1-9 for cells of `cellPx` screen pixels; no-op unless
+       that needs another slot size                                     */
+    void bake(const sf::Font& font, float cellPx)
+    {
+        if (cellPx < DETAIL_PX) return;               // overview only
+        unsigned px = std::min(256u, (unsigned(std::ceil(cellPx)) + 7) / 8 * 8);
+        if (px == slot_) return;
+
+        if (!atlas_) atlas_ = std::make_unique<sf::RenderTexture>();
+        if (!atlas_->create(px * 9, px)) { slot_ = 0; return; }
+        atlas_->clear(sf::Color::Transparent);
+        atlas_->setSmooth(true);
+
+        sf::Text t; t.setFont(font);
+        t.setCharacterSize(px / 2);
+        for (int d = 1; d <= 9; ++d) {
+            t.setString(std::string(1, char('0' + d)));
+            sf::FloatRect b = t.getLocalBounds();
+            t.setOrigin(b.left + b.width  / 2.f,
+                        b.top  + b.height / 2.f);
+            t.setPosition((d - 1) * float(px) + px / 2.f, px / 2.f);
+            atlas_->draw(t);
+        }
+        atlas_->display();
+        slot_ = px;
+        for (Chunk& ch : chunks_) ch.dirty = true;    // texture coords changed
+    }
+
+    /* draw what the target's current view shows (world unit = 1 cell) */
+    void draw(sf::RenderTarget& w, const Board& board)
+    {
+        const sf::View& v = w.getView();
+        sf::Vector2f size = v.getSize(), tl = v.getCenter() - size / 2.f;
+        float cellPx = w.getSize().x * v.getViewport().width / size.x;
+
+        if (cellPx < DETAIL_PX) {
+            uploadOverview(board);
+            overview_->setSmooth(cellPx < 1.f);        // minified: average
+            float cw = float(cols_), rh = float(rows_);
+            ovQuad_[0] = { { 0.f, 0.f }, { 0.f, 0.f } };
+            ovQuad_[1] = { { cw,  0.f }, { cw,  0.f } };
+            ovQuad_[2] = { { cw,  rh  }, { cw,  rh  } };
+            ovQuad_[3] = { { 0.f, rh  }, { 0.f, rh  } };
+            w.draw(ovQuad_, sf::RenderStates(overview_.get()));
+            return;
+        }
+
+        ++frame_;
+        int cr0 = std::max(0, int(std::floor(tl.y)) / CHUNK);
+        int cc0 = std::max(0, int(std::floor(tl.x)) / CHUNK);
+        int cr1 = std::min(crows_ - 1, int(std::floor(tl.y + size.y)) / CHUNK);
+        int cc1 = std::min(ccols_ - 1, int(std::floor(tl.x + size.x)) / CHUNK);
+        for (int cr = cr0; cr <= cr1; ++cr)
+            for (int cc = cc0; cc <= cc1; ++cc) {
+                Chunk& ch = chunks_[std::size_t(cr) * ccols_ + cc];
+                if (ch.dirty) build(ch, board, cr, cc);
+                ch.seen = frame_;
+                w.draw(ch.tiles);
+                if (slot_) w.draw(ch.digits, sf::RenderStates(&atlas_->getTexture()));
+            }
+
+        /* over budget: drop chunks that are out of view */
+        if (built_ > BUDGET)
+            for (Chunk& ch : chunks_)
+                if (ch.built && ch.seen != frame_) release(ch);
+    }
+
+    std::size_t builtChunks() const { return built_; }
+};
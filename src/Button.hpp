@@ -4,6 +4,7 @@
 class Button {
     sf::RectangleShape box_;
     sf::Text           label_;
+    bool               centred_ = false;   // label origin set for its text
 public:
     Button(const sf::Font& f,
            const std::string& txt,
@@ -17,12 +18,24 @@ public:
         box_.setOutlineThickness(2.f);
 
         label_.setFont(f);
-        label_.setString(txt);
         label_.setCharacterSize(static_cast<unsigned>(size.y*0.55f));
-        sf::FloatRect b = label_.getLocalBounds();
-        label_.setOrigin(b.left+b.width/2.f, b.top+b.height/2.f);
-        label_.setPosition(pos + size/2.f);
+        setLabel(txt);
+    }
+    /* centred on the next draw: measuring loads glyphs (LiveText.hpp) */
+    void setLabel(const std::string& txt)
+    {
+        label_.setString(txt);
+        centred_ = false;
     }
     bool contains(sf::Vector2f p) const { return box_.getGlobalBounds().contains(p); }
-    void draw(sf::RenderWindow& w)      { w.draw(box_); w.draw(label_); }
+    void draw(sf::RenderTarget& w)
+    {
+        if (!centred_) {
+            sf::FloatRect b = label_.getLocalBounds();
+            label_.setOrigin(b.left+b.width/2.f, b.top+b.height/2.f);
+            label_.setPosition(box_.getPosition() + box_.getSize()/2.f);
+            centred_ = true;
+        }
+        w.draw(box_); w.draw(label_);
+    }
 };
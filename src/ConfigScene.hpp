@@ -3,33 +3,93 @@
 #include <SFML/Graphics.hpp>
 #include "Scene.hpp"
 #include "Button.hpp"
+#include "StaticLayer.hpp"
 #include "InputBindings.hpp"
 #include "Settings.hpp"
+#include "core/BoardPool.hpp"
 
 class ConfigScene : public Scene {
     sf::Font&        font_;
     InputBindings&   binds_;
     Settings&        set_;
+    BoardPool&       pool_;
+    FilterSteps      steps_;             // filter steps for set_.rules
     Button           back_;
     SceneID          next_ = SceneID::None;
 
     enum class WaitFor { None, Restart, Select };
     WaitFor waiting_ = WaitFor::None;
     sf::Text text_;
+    StaticLayer layer_;                  // button + text, repainted on change
 
     void refreshText() {
         std::ostringstream ss;
         ss << "Key bindings / options\n\n"
            << "[1] Restart:       " << keyName(binds_.restart)     << '\n'
            << "[2] Select / hold: " << keyName(binds_.selectHold)  << '\n'
-           << "[3] Show FPS:      " << (set_.showFPS ? "On" : "Off") << '\n';
+           << "[3] Show FPS:      " << (set_.showFPS ? "On" : "Off") << '\n'
+           << "[4] Board filter:  ";
+        static const char* const strictness[] = { "", " (mild)", " (medium)", " (strict)" };
+        if (!steps_.usable())   ss << "n/a on marathon boards\n";
+        else if (set_.minMoves) ss << ">= " << set_.minMoves << " moves"
+                                   << strictness[steps_.level(set_.minMoves)] << '\n';
+        else                    ss << "Off\n";
+        ss << "[5] Profiler:      " << (set_.showProfiler ? "On" : "Off") << '\n'
+           << "[6] Pacing:        ";
+        if      (set_.pacing == Pacing::VSync)    ss << "VSync\n";
+        else if (set_.pacing == Pacing::Uncapped) ss << "Uncapped\n";
+        else                                      ss << "Limit " << set_.frameCap << " Hz\n";
+        ss << "[7] Board:         " << set_.rules.rows << " x " << set_.rules.cols
+           << (set_.rules == presetRules() ? " (standard)\n" : " (marathon)\n");
         if (waiting_ != WaitFor::None) ss << "\nPress a key...";
         text_.setString(ss.str());
+        layer_.invalidate();
+        dirty_ = true;
+    }
+
+    /* Off → mild → medium → strict → Off, measured on the rules in
+       force (filterSteps); nothing to cycle on marathon boards         */
+    void cycleFilter() {
+        int next = (steps_.level(set_.minMoves) + 1) % (FilterSteps::COUNT + 1);
+        set_.minMoves = steps_.usable() ? steps_.at(next) : 0;
+        pool_.setMinMoves(set_.minMoves);
+    }
+
+    /* VSync → Uncapped → Limit 60 … 360 Hz → VSync */
+    void cyclePacing() {
+        static const int caps[] = { 60, 120, 144, 165, 240, 360 };
+        if (set_.pacing == Pacing::VSync)    { set_.pacing = Pacing::Uncapped; return; }
+        if (set_.pacing == Pacing::Uncapped) { set_.pacing = Pacing::Limit; set_.frameCap = caps[0]; return; }
+        int i = 0;
+        while (i < 5 && caps[i] != set_.frameCap) ++i;
+        if (i >= 5) set_.pacing = Pacing::VSync;
+        else        set_.frameCap = caps[i + 1];
+    }
+
+    /* the rule preset's own board, at its own size */
+    Rules presetRules() const {
+        int p = presetOf(set_.rules);
+        return p < 0 ? set_.rules : PRESETS[p].rules;
+    }
+
+    /* the preset's board → marathon boards → the preset's board */
+    void cycleBoard() {
+        const Rules own = presetRules();
+        const int sizes[][2] = { { own.rows, own.cols }, { 40, 68 },
+                                 { 100, 170 }, { 1000, 1000 } };
+        int i = 0;
+        while (i < 4 && (sizes[i][0] != set_.rules.rows || sizes[i][1] != set_.rules.cols)) ++i;
+        i = (i + 1) % 4;
+        const Rules old = set_.rules;
+        set_.rules    = set_.rules.sized(sizes[i][0], sizes[i][1]);
+        set_.minMoves = rescaleFilter(old, set_.rules, set_.minMoves);
+        steps_        = filterSteps(set_.rules);
+        pool_.setMinMoves(set_.minMoves);
     }
 
 public:
-    ConfigScene(sf::Font& f, InputBindings& b, Settings& s)
-        : font_(f), binds_(b), set_(s),
+    ConfigScene(sf::Font& f, InputBindings& b, Settings& s, BoardPool& p)
+        : font_(f), binds_(b), set_(s), pool_(p), steps_(filterSteps(s.rules)),
           back_(f, "Back", {60.f, 60.f}, {180.f, 60.f})
     {
         text_.setFont(font_);
@@ -49,6 +109,10 @@ public:
             if      (y >= 56  && y < 84)  { waiting_ = WaitFor::Restart; refreshText(); }
             else if (y >= 84  && y < 112) { waiting_ = WaitFor::Select;  refreshText(); }
             else if (y >= 112 && y < 140) { set_.showFPS = !set_.showFPS; refreshText(); }
+            else if (y >= 140 && y < 168) { cycleFilter(); refreshText(); }
+            else if (y >= 168 && y < 196) { set_.showProfiler = !set_.showProfiler; refreshText(); }
+            else if (y >= 196 && y < 224) { cyclePacing(); refreshText(); }
+            else if (y >= 224 && y < 252) { cycleBoard();  refreshText(); }
         }
         else if (e.type == sf::Event::KeyPressed && waiting_ != WaitFor::None) {
             if (waiting_ == WaitFor::Restart)     binds_.restart    = e.key.code;
@@ -59,7 +123,8 @@ public:
     }
 
     void update(float) override {}
-    void draw(sf::RenderWindow& w) override { back_.draw(w); w.draw(text_); }
+    void draw(sf::RenderTarget& w) override
+    { layer_.draw(w, [&](sf::RenderTarget& t) { back_.draw(t); t.draw(text_); }); }
 
     SceneID next() const override { return next_; }
     void    resetNext()  override { next_ = SceneID::None; }
@@ -0,0 +1,87 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Frame limiter with late input sampling (Pacing::Limit)
+ *  – frames are presented on a fixed period (1 / cap); the deadline
+ *    advances in whole periods and resyncs after a stall instead of
+ *    bursting to catch up
+ *  – the loop waits *before* reading input, until the deadline minus
+ *    the expected cost of a frame (input → present, a decaying high-
+ *    water mark), so input is sampled as late as possible and the
+ *    frame still makes its slot
+ *  – waiting is a coarse sleep to within the learned oversleep of
+ *    sf::sleep (which raises the Windows timer resolution), then a
+ *    spin on the clock for the last stretch
+ * ------------------------------------------------------------------ */
+#include <SFML/System.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+class FramePacer {
+    using clock = std::chrono::steady_clock;
+    using us    = std::chrono::microseconds;
+
+    static constexpr float GUARD = 300.f;        // µs kept in hand per frame
+
+    us                period_{0};                // 0: not limiting
+    clock::time_point deadline_;                 // present time of the next frame
+    clock::time_point sampled_;
+    bool              armed_ = false;            // sampled_ belongs to this frame
+    float             work_  = 2000.f;           // µs from input to present
+    float             slack_ = 1000.f;           // µs sf::sleep may overshoot
+
+    static float micros(clock::duration d)
+    { return float(std::chrono::duration_cast<us>(d).count()); }
+
+    void sleepUntil(clock::time_point t)
+    {
+        for (;;) {
+            clock::time_point now = clock::now();
+            float left = micros(t - now);
+            if (left <= 0.f) return;
+            if (left > slack_) {
+                float want = left - slack_;
+                sf::sleep(sf::microseconds(sf::Int64(want)));
+                float over = micros(clock::now() - now) - want;
+                slack_ = std::max(over, slack_ + (over - slack_) / 16.f);
+                slack_ = std::max(slack_, 100.f);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+public:
+    void setRate(int hz)
+    {
+        period_   = us(hz > 0 ? 1000000 / hz : 0);
+        deadline_ = clock::now() + period_;
+    }
+
+    bool limiting() const { return period_.count() > 0; }
+
+    /* sleep until input should be read for the next frame */
+    void waitToSample()
+    {
+        if (!limiting()) return;
+        clock::time_point now = clock::now();
+        if (deadline_ < now || deadline_ - now > 4 * period_)
+            deadline_ = now + period_;               // idle or stalled: resync
+        sleepUntil(deadline_ - us(std::int64_t(work_ + GUARD)));
+        sampled_ = clock::now();
+        armed_   = true;
+    }
+
+    /* right after display(): learn the frame cost, book the next slot */
+    void presented()
+    {
+        if (!limiting()) return;
+        clock::time_point now = clock::now();
+        if (armed_) {
+            float w = micros(now - sampled_);
+            work_ = w > work_ ? w : work_ + (w - work_) / 32.f;
+            armed_ = false;
+        }
+        do deadline_ += period_; while (deadline_ <= now);
+    }
+};
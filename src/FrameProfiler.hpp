@@ -0,0 +1,198 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Frame-time profiler
+ *  – the main loop marks the end of each phase (events, update, draw,
+ *    present); one sample per frame goes into a fixed ring buffer
+ *  – single producer, lock-free: a slot is filled, then the write
+ *    counter is published with release order, so readers on any
+ *    thread see complete samples of the last CAPACITY frames
+ *  – percentiles over a recent window for the overlay
+ *  – input lag: from when input arrived to the end of Present. The
+ *    window system does not timestamp events, so input found by a poll
+ *    is taken to have arrived halfway since the previous poll; input
+ *    that woke an idle wait arrived at the wake-up; with a render
+ *    thread the update thread stamps input as it takes it (arrived())
+ *  – heap allocations and bytes per phase, made by the main thread
+ *    (see AllocCount.hpp; all zero unless the hooks are compiled in)
+ *  – Chrome trace-event JSON (chrome://tracing, Perfetto) on demand
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "AllocCount.hpp"
+
+class FrameProfiler {
+public:
+    enum Phase { Events, Update, Draw, Present, PhaseCount };
+    static constexpr std::size_t CAPACITY = 8192;     // ~2 min at 60 Hz
+
+    struct Frame {
+        std::int64_t start = 0;                        // µs since profiler start
+        std::int32_t dur[PhaseCount] = {};             // µs per phase
+        std::int32_t lag = 0;                          // µs input → present, 0 = no input
+        std::int32_t allocs[PhaseCount] = {};          // operator new calls per phase
+        std::int64_t bytes[PhaseCount]  = {};          // ... and bytes asked for
+        std::int32_t total() const { return dur[0] + dur[1] + dur[2] + dur[3]; }
+    };
+
+    struct Stats {
+        float p50 = 0, p95 = 0, p99 = 0, worst = 0, lag = 0;   // ms; lag: median
+        float allocs[PhaseCount] = {};                 // mean per frame
+        float bytes = 0;                               // mean per frame, all phases
+    };
+
+    static const char* phaseName(int p)
+    {
+        static const char* names[PhaseCount] = { "events", "update", "draw", "present" };
+        return names[p];
+    }
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    std::array<Frame, CAPACITY>  ring_;
+    std::atomic<std::uint64_t>   written_{0};
+    clock::time_point            epoch_ = clock::now();
+    clock::time_point            last_;
+    AllocCount                   lastAlloc_;
+    clock::time_point            polled_ = epoch_;   // previous input read
+    clock::time_point            arrived_;           // input of this frame
+    bool                         input_ = false;
+    Frame                        cur_;
+    mutable std::vector<std::int32_t> scratch_;
+
+    std::int64_t micros(clock::time_point t) const
+    { return std::chrono::duration_cast<std::chrono::microseconds>(t - epoch_).count(); }
+
+public:
+    FrameProfiler() { scratch_.reserve(CAPACITY); }
+
+    void beginFrame()
+    {
+        last_ = clock::now();
+        lastAlloc_ = allocCount();
+        cur_  = Frame{};
+        cur_.start = micros(last_);
+        input_ = false;
+    }
+
+    /* an idle wait just returned with input */
+    void woke()
+    {
+        arrived_ = polled_ = clock::now();
+        input_   = true;
+    }
+
+    /* the loop just drained the event queue; any = it held something */
+    void polled(bool any)
+    {
+        clock::time_point now = clock::now();
+        if (any && !input_) { arrived_ = polled_ + (now - polled_) / 2; input_ = true; }
+        polled_ = now;
+    }
+
+    /* input taken at t on another thread is shown by this frame */
+    void arrived(std::chrono::steady_clock::time_point t)
+    {
+        if (!input_ || t < arrived_) arrived_ = t;
+        input_ = true;
+    }
+
+    /* close phase p: everything since the previous mark belongs to it */
+    void mark(Phase p)
+    {
+        clock::time_point now = clock::now();
+        cur_.dur[p] += std::int32_t(std::chrono::duration_cast<
+                           std::chrono::microseconds>(now - last_).count());
+        last_ = now;
+        AllocCount a = allocCount(), d = a - lastAlloc_;
+        cur_.allocs[p] += std::int32_t(d.allocs);
+        cur_.bytes[p]  += d.bytes;
+        lastAlloc_ = a;
+    }
+
+    void endFrame()
+    {
+        if (input_ && cur_.dur[Present] > 0)
+            cur_.lag = std::int32_t(std::chrono::duration_cast<
+                           std::chrono::microseconds>(last_ - arrived_).count());
+        std::uint64_t n = written_.load(std::memory_order_relaxed);
+        ring_[n % CAPACITY] = cur_;
+        written_.store(n + 1, std::memory_order_release);
+    }
+
+    std::uint64_t frames() const { return written_.load(std::memory_order_acquire); }
+
+    /* i-th most recent frame, 0 = newest; i must be < min(frames, CAPACITY) */
+    const Frame& recent(std::size_t i) const
+    { return ring_[(frames() - 1 - i) % CAPACITY]; }
+
+    Stats stats(std::size_t window) const
+    {
+        Stats s;
+        std::size_t n = std::size_t(std::min<std::uint64_t>(frames(), std::min(window, CAPACITY)));
+        if (!n) return s;
+        scratch_.clear();
+        for (std::size_t i = 0; i < n; ++i) scratch_.push_back(recent(i).total());
+
+        auto pct = [&](double q) {
+            auto it = scratch_.begin() + std::ptrdiff_t(q * (n - 1));
+            std::nth_element(scratch_.begin(), it, scratch_.end());
+            return *it / 1000.f;
+        };
+        s.p50   = pct(0.50);
+        s.p95   = pct(0.95);
+        s.p99   = pct(0.99);
+        s.worst = *std::max_element(scratch_.begin(), scratch_.end()) / 1000.f;
+
+        scratch_.clear();
+        for (std::size_t i = 0; i < n; ++i)
+            if (recent(i).lag > 0) scratch_.push_back(recent(i).lag);
+        if (!scratch_.empty()) {
+            auto mid = scratch_.begin() + std::ptrdiff_t(scratch_.size() / 2);
+            std::nth_element(scratch_.begin(), mid, scratch_.end());
+            s.lag = *mid / 1000.f;
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+            for (int p = 0; p < PhaseCount; ++p) {
+                s.allocs[p] += float(recent(i).allocs[p]) / n;
+                s.bytes     += float(recent(i).bytes[p])  / n;
+            }
+        return s;
+    }
+
+    /* one complete ("X") event per phase per frame, oldest first */
+    bool writeTrace(const std::string& path) const
+    {
+        std::ofstream f(path, std::ios::trunc);
+        if (!f) return false;
+        std::size_t n = std::size_t(std::min<std::uint64_t>(frames(), CAPACITY));
+        f << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (std::size_t i = n; i-- > 0; ) {
+            const Frame& fr = recent(i);
+            std::int64_t t = fr.start;
+            f << (first ? "" : ",\n")
+              << "{\"name\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << t
+              << ",\"dur\":" << fr.total() << '}';
+            first = false;
+            for (int p = 0; p < PhaseCount; ++p) {
+                f << ",\n{\"name\":\"" << phaseName(p)
+                  << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << t
+                  << ",\"dur\":" << fr.dur[p]
+                  << ",\"args\":{\"allocs\":" << fr.allocs[p]
+                  << ",\"bytes\":" << fr.bytes[p] << "}}";
+                t += fr.dur[p];
+            }
+        }
+        f << "\n],\"displayTimeUnit\":\"ms\"}\n";
+        return bool(f);
+    }
+};
@@ -1,121 +1,293 @@
 #pragma once
 /* --------------------------------------------------------------------
  *  Fruit-Box “Game” scene
- *  – 10×17 grid of apples
- *  – 2-minute timer
- *  – selectable rectangles that disappear if they sum to 10
+ *  – grid of apples, drawn from a pool of vetted seeds: the classic
+ *    10×17 or a marathon board of up to 1000×1000 (Settings)
+ *  – camera (sf::View, one world unit per cell): wheel zooms at the
+ *    cursor, right / middle drag pans, Home fits the whole board
+ *  – 2-minute timer, stepped in fixed ticks (see Round)
+ *  – selectable rectangles that disappear if they sum to the target
+ *    of the rule preset picked on the menu (10 classic, Rules.hpp)
+ *  – live sum of the dragged rectangle (O(1) via the board's SAT)
+ *  – index of every valid move (core/MoveIndex.hpp), updated per clear:
+ *    moves-left count in the HUD, hint key, and an early end with a
+ *    time bonus as soon as no move is left
+ *  – cleared apples drop and throw sparks (core/Particles.hpp), drawn
+ *    through the camera as one batch of quads
  *  – optional FPS display
+ *  – a frame that only redraws allocates nothing: shapes and texts are
+ *    members, rewritten in place (LiveText.hpp)
+ *  – draw() reads only what publish() copied into a triple buffer
+ *    (board, camera, selection, HUD values, particle quads), so with
+ *    --render-thread it runs beside handleEvent() / update(); moves
+ *    reach each slot's board and the renderer as a short log of
+ *    changed rectangles, so a move costs the same on any board size
  *  – writes the score to the persistent leaderboard when time is up
+ *    (classic boards only, so the leaderboard stays comparable)
+ *  The rules themselves (board, scoring, timer) live in core/Round.hpp.
  * ------------------------------------------------------------------ */
 #include <SFML/Graphics.hpp>
 #include <vector>
-#include <random>
-#include <iomanip>
-#include <sstream>
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 
 #include "Scene.hpp"
 #include "InputBindings.hpp"
 #include "Settings.hpp"
 #include "ScoreStore.hpp"
+#include "BoardRenderer.hpp"
+#include "LiveText.hpp"
+#include "core/Round.hpp"
+#include "core/MoveIndex.hpp"
+#include "core/BoardPool.hpp"
+#include "core/Particles.hpp"
+#include "core/TripleBuffer.hpp"
 
 class GameScene : public Scene {
     /* ------------ injected from the outside ----------------------- */
     sf::Font&        font_;
     InputBindings&   binds_;
     Settings&        set_;
+    BoardPool&       pool_;
 
     /* ------------ scene-to-scene plumbing ------------------------- */
     SceneID          next_     = SceneID::None;
 
-    /* ------------ board data -------------------------------------- */
-    static constexpr int ROWS = 10, COLS = 17;
-    std::vector<std::vector<int>>  value_;   // 1-9 per cell
-    std::vector<std::vector<bool>> alive_;   // true = still visible
+    /* ------------ rules (board, score, timer) --------------------- */
+    Round        round_;
+    MoveIndex    moves_;                     // every valid move on the board
+    std::vector<int> cleared_;               // cells removed by the last move
 
-    /* ------------ geometry cache ---------------------------------- */
-    float        cell_   = 0.f;              // side of a square cell in px
-    sf::Vector2f origin_;                    // top-left corner of grid
+    /* ------------ camera ------------------------------------------ */
+    static constexpr float MAX_PX = 160.f;   // most px per cell when zoomed in
+    sf::Vector2f win_;                       // window size in px
+    sf::Vector2f center_;                    // camera centre, in cells
+    float        scale_    = 1.f;            // px per cell
+    bool         fitted_   = true;           // camera tracks the whole board
+    bool         panning_  = false;
+    sf::Vector2i panFrom_;                   // last pan position (px)
+    Particles    particles_;                 // clearing effects, in cells
 
     /* ------------ selection state --------------------------------- */
     bool         dragging_ = false;
     sf::Vector2i a_, b_;                     // drag endpoints (cell coords)
+    int          selSum_   = 0;              // live sum inside a_..b_
+    bool         hinting_  = false;
+    Rect         hint_;                      // shown until the next move
 
-    /* ------------ game state -------------------------------------- */
-    int          score_      = 0;
-    float        timeLeft_   = 120.f;        // seconds
-    float        fpsSmooth_  = 0.f;          // exponential-moving FPS
+    /* ------------ app state --------------------------------------- */
     bool         recorded_   = false;        // prevents double logging
-    std::mt19937 rng_{std::random_device{}()};
+    int          shownSecs_  = -1;           // clock value last published
+    float        linger_     = 0.f;          // s to show an early finish
+
+    /* ------------ published for draw() ---------------------------- */
+    static constexpr std::uint64_t CHANGES = 32;   // moves the log keeps
+    static constexpr std::size_t   SPARK_ROOM = 1024;   // particles per slot before it grows
+    struct View {
+        Board         board;                 // kept up to date from changes_
+        std::uint32_t boardId  = 0;          // bumped by resetBoard()
+        std::uint64_t boardVer = 0;          // moves applied to the board
+        Rect          changes[CHANGES];      // move v cleared changes[v % CHANGES]
+        sf::Vector2f  win, center;           // px; camera centre in cells
+        float         scale    = 1.f;
+        bool          dragging = false, hinting = false, finished = false;
+        bool          showFPS  = false;
+        Rect          sel, hint;
+        int           selSum = 0, score = 0, moves = 0, secs = 0, bonus = 0;
+        int           target = Round::TARGET;
+        std::uint64_t seed   = 0;
+        std::vector<sf::Vertex> sparks;      // 4 per particle, SPARK_ROOM or the most
+        std::size_t   sparkCount = 0;        // ... of which in use
+    };
+    std::uint32_t    boardId_  = 0;
+    std::uint64_t    boardVer_ = 0;
+    Rect             changes_[CHANGES];
+    TripleBuffer<View> views_;
+
+    /* ------------ render side: only draw() touches these ---------- */
+    BoardRenderer renderer_;                 // chunked tiles + digit atlas
+    std::uint32_t drawnId_  = ~0u;           // board the renderer holds
+    std::uint64_t drawnVer_ = 0;
+    sf::Clock    drawClock_;
+    float        fpsSmooth_ = 0.f;           // exponential-moving FPS
+    bool         warmed_    = false;         // HUD glyphs rasterised (first draw)
+    sf::RectangleShape hintBox_, selBox_;
+    LiveText     hud_      { font_, 26 };        // score, moves, clock
+    LiveText     sumText_  { font_, 22 };        // running selection sum
+    LiveText     seedText_ { font_, 16 };
+    LiveText     fpsText_  { font_, 18 };
+    LiveText     doneText_ { font_, 40 };        // early finish banner
 
 public:
     GameScene(sf::Font& f,
               InputBindings& b,
               Settings& s,
+              BoardPool& p,
               sf::Vector2u  winSize)
-        : font_(f), binds_(b), set_(s)
+        : font_(f), binds_(b), set_(s), pool_(p)
     {
+        hintBox_.setFillColor(sf::Color::Transparent);
+        hintBox_.setOutlineThickness(3.f);
+        hintBox_.setOutlineColor(sf::Color::Cyan);
+        selBox_.setFillColor(sf::Color::Transparent);
+        selBox_.setOutlineThickness(3.f);
+        sumText_.setOutlineColor(sf::Color::Black);
+        sumText_.setOutlineThickness(2.f);
+        seedText_.setFillColor(sf::Color(160, 160, 160));
+        seedText_.setPosition(10.f, 10.f);
+        doneText_.setOutlineColor(sf::Color::Black);
+        doneText_.setOutlineThickness(3.f);
+
         resetBoard();
-        recalcGeometry(winSize);
+        resize(winSize);
     }
 
     /* ------------- helpers ---------------------------------------- */
-    void recalcGeometry(sf::Vector2u w)
+    void resize(sf::Vector2u w)
+    {
+        win_ = { float(w.x), float(w.y) };
+        if (fitted_) fit(); else clampCamera();
+    }
+
+    /* smallest zoom: the whole board fits the window */
+    float fitScale() const
+    { return std::min(win_.x / round_.cols(), win_.y / round_.rows()); }
+
+    void fit()
+    {
+        scale_  = fitScale();
+        center_ = { round_.cols() / 2.f, round_.rows() / 2.f };
+        fitted_ = true;
+    }
+
+    void clampCamera()
+    {
+        scale_     = std::clamp(scale_, fitScale(), std::max(fitScale(), MAX_PX));
+        center_.x  = std::clamp(center_.x, 0.f, float(round_.cols()));
+        center_.y  = std::clamp(center_.y, 0.f, float(round_.rows()));
+    }
+
+    /* zoom by `factor`, keeping the cell under pixel p where it is */
+    void zoomAt(sf::Vector2f p, float factor)
     {
-        cell_   = std::min(w.x / float(COLS), w.y / float(ROWS));
-        origin_ = { (w.x - cell_ * COLS) / 2.f,
-                    (w.y - cell_ * ROWS) / 2.f };
+        sf::Vector2f world = winToWorld(p);
+        scale_ *= factor;
+        clampCamera();
+        center_ = world - (p - win_ / 2.f) / scale_;
+        clampCamera();
+        if (scale_ <= fitScale()) fit();           // all the way out: re-centre
+        else fitted_ = false;
     }
 
     void resetBoard()
     {
-        value_.assign(ROWS, std::vector<int>(COLS));
-        alive_.assign(ROWS, std::vector<bool>(COLS, true));
-        std::uniform_int_distribution<int> d(1, 9);
-        for (auto& row : value_)
-            for (int& v : row) v = d(rng_);
-        score_     = 0;
-        timeLeft_  = 120.f;
+        if (pool_.minMoves() != set_.minMoves)    // the menu may have rescaled it
+            pool_.setMinMoves(set_.minMoves);
+        round_.reset(pool_.take(set_.rules), set_.rules);
         recorded_  = false;
+        hinting_   = false;
+        linger_    = 0.f;
+        ++boardId_;
+        boardVer_  = 0;
+        moves_.build(round_.board(), round_.target());
+        cleared_.reserve(std::size_t(round_.target()));   // a move clears at most target cells
+        if (!moves_.count()) round_.finish();
+        particles_.clear();
     }
 
+    /* every valid move; the allocation check plays from it */
+    const MoveIndex& moves() const { return moves_; }
+
     bool valid(sf::Vector2i c) const
-    { return c.x >= 0 && c.x < COLS && c.y >= 0 && c.y < ROWS; }
+    { return c.x >= 0 && c.x < round_.cols() && c.y >= 0 && c.y < round_.rows(); }
+
+    sf::Vector2f winToWorld(sf::Vector2f p) const
+    { return center_ + (p - win_ / 2.f) / scale_; }
+
+    sf::Vector2f worldToWin(sf::Vector2f q) const
+    { return (q - center_) * scale_ + win_ / 2.f; }
+
+    /* the same through a published camera, for draw() */
+    static sf::Vector2f worldToWin(const View& v, sf::Vector2f q)
+    { return (q - v.center) * v.scale + v.win / 2.f; }
+
+    /* highlight the smallest valid move; bring it into view */
+    void showHint()
+    {
+        if (round_.over() || !moves_.hint(hint_)) return;
+        hinting_ = true;
+        sf::Vector2f tl = worldToWin({ float(hint_.c1), float(hint_.r1) });
+        sf::Vector2f br = worldToWin({ float(hint_.c2 + 1), float(hint_.r2 + 1) });
+        if (tl.x < 0 || tl.y < 0 || br.x > win_.x || br.y > win_.y) {
+            center_ = { (hint_.c1 + hint_.c2 + 1) / 2.f, (hint_.r1 + hint_.r2 + 1) / 2.f };
+            clampCamera();
+            fitted_ = false;
+        }
+    }
 
     sf::Vector2i winToCell(sf::Vector2f p) const
     {
-        p -= origin_;
-        return { int(p.x / cell_), int(p.y / cell_) };
+        sf::Vector2f q = winToWorld(p);
+        return { int(std::floor(q.x)), int(std::floor(q.y)) };
     }
 
+    int  secondsLeft() const { return round_.ticksLeft() / Round::TICK_HZ; }
+
+    Rect selection() const { return Rect::span(a_.y, a_.x, b_.y, b_.x); }
+    int  selectionSum() const { return round_.sum(selection()); }
+
     void applySelection()
     {
-        int r1 = std::min(a_.y, b_.y), r2 = std::max(a_.y, b_.y);
-        int c1 = std::min(a_.x, b_.x), c2 = std::max(a_.x, b_.x);
-
-        int sum = 0;
-        for (int r = r1; r <= r2; ++r)
-            for (int c = c1; c <= c2; ++c)
-                if (alive_[r][c]) sum += value_[r][c];
-
-        if (sum == 10) {
-            ++score_;
-            for (int r = r1; r <= r2; ++r)
-                for (int c = c1; c <= c2; ++c)
-                    alive_[r][c] = false;
-        }
+        Rect s = selection();
+        if (!round_.apply(s, &cleared_)) return;
+        changes_[++boardVer_ % CHANGES] = s;
+        moves_.update(round_.board(), cleared_);
+        for (int i : cleared_) particles_.burst(i / round_.cols(), i % round_.cols());
+        hinting_ = false;
+        if (!moves_.count()) round_.finish();        // nothing left to find
     }
 
     /* ------------- Scene interface -------------------------------- */
     void handleEvent(const sf::Event& e) override
     {
         if (e.type == sf::Event::Resized)
-            recalcGeometry({ e.size.width, e.size.height });
+            resize({ e.size.width, e.size.height });
+
+        /* anything below may change the picture */
+        if (e.type == sf::Event::KeyPressed || e.type == sf::Event::MouseButtonPressed ||
+            e.type == sf::Event::MouseButtonReleased ||
+            e.type == sf::Event::MouseWheelScrolled ||
+            (e.type == sf::Event::MouseMoved && (dragging_ || panning_)))
+            dirty_ = true;
 
         /* ---- keyboard shortcuts ---- */
         if (e.type == sf::Event::KeyPressed) {
             if (e.key.code == binds_.restart)            resetBoard();
             else if (e.key.code == sf::Keyboard::Escape) next_ = SceneID::Menu;
+            else if (e.key.code == sf::Keyboard::Home)   fit();
+            else if (e.key.code == binds_.hint)          showHint();
+        }
+
+        /* ---- camera ---- */
+        if (e.type == sf::Event::MouseWheelScrolled &&
+            e.mouseWheelScroll.wheel == sf::Mouse::VerticalWheel)
+            zoomAt({ float(e.mouseWheelScroll.x), float(e.mouseWheelScroll.y) },
+                   std::pow(1.25f, e.mouseWheelScroll.delta));
+        else if (e.type == sf::Event::MouseButtonPressed &&
+                 (e.mouseButton.button == sf::Mouse::Right ||
+                  e.mouseButton.button == sf::Mouse::Middle))
+        { panning_ = true; panFrom_ = { e.mouseButton.x, e.mouseButton.y }; }
+        else if (e.type == sf::Event::MouseButtonReleased &&
+                 (e.mouseButton.button == sf::Mouse::Right ||
+                  e.mouseButton.button == sf::Mouse::Middle))
+            panning_ = false;
+        else if (e.type == sf::Event::MouseMoved && panning_) {
+            sf::Vector2i to(e.mouseMove.x, e.mouseMove.y);
+            center_ -= sf::Vector2f(to - panFrom_) / scale_;
+            panFrom_ = to;
+            clampCamera();
+            fitted_ = false;
         }
 
         /* ---- mouse selection ---- */
@@ -124,12 +296,12 @@ public:
         {
             sf::Vector2i c = winToCell({ float(e.mouseButton.x),
                                          float(e.mouseButton.y) });
-            if (valid(c)) { dragging_ = true; a_ = b_ = c; }
+            if (valid(c)) { dragging_ = true; a_ = b_ = c; selSum_ = selectionSum(); }
         }
         else if (e.type == sf::Event::MouseMoved && dragging_) {
             sf::Vector2i c = winToCell({ float(e.mouseMove.x),
                                          float(e.mouseMove.y) });
-            if (valid(c)) b_ = c;
+            if (valid(c) && c != b_) { b_ = c; selSum_ = selectionSum(); }
         }
         else if (e.type == sf::Event::MouseButtonReleased &&
                  e.mouseButton.button == sf::Mouse::Left && dragging_)
@@ -141,90 +313,167 @@ public:
 
     void update(float dt) override
     {
-        /* countdown */
-        timeLeft_ -= dt;
+        /* countdown: whole fixed ticks; dt arrives quantised to µs */
+        round_.advance(std::llround(double(dt) * 1e6));
 
         /* log score & exit round once */
-        if (timeLeft_ <= 0.f && !recorded_) {
-            ScoreStore::append(score_, set_.scores);   // persistent write
+        if (round_.over() && !recorded_) {
+            RoundRecord r;
+            r.score      = round_.score();
+            r.moves      = round_.moves();
+            r.durationMs = round_.elapsedMs();
+            r.time       = ScoreStore::now();
+            r.seed       = round_.seed();
+            if (round_.classic()) set_.history.add(r); // durable, O(1)
             recorded_ = true;
+            if (round_.finished()) linger_ = 2.5f;      // show the bonus first
+            else                   next_ = SceneID::Menu;
+        }
+        else if (linger_ > 0.f && (linger_ -= dt) <= 0.f)
             next_ = SceneID::Menu;
+
+        /* effects: one more redraw after the last particle is gone */
+        if (!particles_.empty()) { particles_.update(dt); dirty_ = true; }
+
+        if (set_.showFPS || secondsLeft() != shownSecs_) dirty_ = true;
+    }
+
+    /* idle until the clock shows the next second; the FPS counter and
+       running effects are live                                          */
+    float wakeAfter() const override
+    {
+        if (set_.showFPS || !particles_.empty()) return 0.f;
+        if (linger_ > 0.f) return linger_;
+        if (round_.over()) return 0.f;             // record it on the next update
+        int ticks = round_.ticksLeft() % Round::TICK_HZ + 1;   // to the next whole second
+        return float(ticks) / Round::TICK_HZ;
+    }
+
+    /* copy what draw() reads. The slot's board is brought up to date by
+       replaying the moves it missed from the change log – a clear is
+       deterministic, so the same rectangles give the same board – and
+       copied whole only for a new board or one too far behind          */
+    bool snapshots() const override { return true; }
+
+    void publish() override
+    {
+        View& v = views_.back();
+        if (v.boardId != boardId_ || boardVer_ - v.boardVer > CHANGES)
+            v.board = round_.board();
+        else
+            for (std::uint64_t k = v.boardVer + 1; k <= boardVer_; ++k) {
+                const Rect& r = changes_[k % CHANGES];
+                v.board.clear(r.r1, r.c1, r.r2, r.c2);
+            }
+        if (v.boardId != boardId_ || v.boardVer != boardVer_) {
+            v.boardId  = boardId_;
+            v.boardVer = boardVer_;
+            std::copy(std::begin(changes_), std::end(changes_), std::begin(v.changes));
         }
+        v.win      = win_;   v.center = center_;   v.scale = scale_;
+        v.dragging = dragging_; v.sel = selection(); v.selSum = selSum_;
+        v.hinting  = hinting_;  v.hint = hint_;
+        v.score    = round_.score();
+        v.moves    = moves_.count();
+        v.secs     = shownSecs_ = secondsLeft();
+        v.finished = round_.finished();
+        v.bonus    = round_.bonus();
+        v.showFPS  = set_.showFPS;
+        v.seed     = round_.seed();
+        v.target   = round_.target();
 
-        /* smooth FPS for HUD */
-        fpsSmooth_ = 0.9f * fpsSmooth_ + 0.1f * (1.f / dt);
+        v.sparkCount = particles_.size();
+        if (v.sparks.size() < v.sparkCount * 4)
+            v.sparks.resize(std::max(v.sparkCount, SPARK_ROOM) * 4);
+        particles_.quads(v.sparks.data());
+        views_.publish();
     }
 
-    void draw(sf::RenderWindow& w) override
+    void draw(sf::RenderTarget& w) override
     {
-        /* ---- draw grid ---- */
-        sf::RectangleShape tile({ cell_ - 1, cell_ - 1 });
-        sf::Text t; t.setFont(font_);
-        t.setCharacterSize(static_cast<unsigned>(cell_ * 0.5f));
-
-        for (int r = 0; r < ROWS; ++r)
-            for (int c = 0; c < COLS; ++c)
-            {
-                tile.setPosition(origin_.x + c * cell_,
-                                 origin_.y + r * cell_);
-
-                if (alive_[r][c]) {
-                    tile.setFillColor(sf::Color(200, 80, 80));
-                    w.draw(tile);
-
-                    t.setString(std::to_string(value_[r][c]));
-                    sf::FloatRect b = t.getLocalBounds();
-                    t.setOrigin(b.left + b.width  / 2.f,
-                                b.top  + b.height / 2.f);
-                    t.setPosition(tile.getPosition() +
-                                  sf::Vector2f(cell_ / 2, cell_ / 2));
-                    w.draw(t);
-                }
-                else {                        // empty / removed
-                    tile.setFillColor(sf::Color(40, 40, 40));
-                    w.draw(tile);
-                }
+        views_.acquire();
+        const View& v = views_.front();
+        if (!warmed_) {
+            for (const LiveText* t : { &hud_, &sumText_, &fpsText_, &doneText_ }) t->prewarm();
+            seedText_.prewarm("Seed x0123456789abcdef sum");   // a new board, new digits
+            warmed_ = true;
+        }
+
+        /* ---- catch the renderer up with the published board ---- */
+        if (v.boardId != drawnId_)
+            seedText_.set("Seed 0x%016llx   sum %d", static_cast<unsigned long long>(v.seed),
+                          v.target);
+        if (v.boardId != drawnId_ || v.boardVer - drawnVer_ > CHANGES)
+            renderer_.reset(v.board);
+        else
+            for (std::uint64_t k = drawnVer_ + 1; k <= v.boardVer; ++k) {
+                const Rect& r = v.changes[k % CHANGES];
+                renderer_.invalidate(r.r1, r.c1, r.r2, r.c2);
             }
+        drawnId_  = v.boardId;
+        drawnVer_ = v.boardVer;
+
+        /* ---- board through the camera: visible chunks only ---- */
+        w.setView(sf::View(v.center, v.win / v.scale));
+        renderer_.bake(font_, v.scale);            // no-op unless the slot changes
+        renderer_.draw(w, v.board);
+        if (v.sparkCount) w.draw(v.sparks.data(), v.sparkCount * 4, sf::Quads);
+        w.setView(sf::View(sf::FloatRect(0.f, 0.f, v.win.x, v.win.y)));   // HUD in px
+
+        /* ---- hint ---- */
+        if (v.hinting) {
+            sf::Vector2f tl = worldToWin(v, { float(v.hint.c1), float(v.hint.r1) });
+            sf::Vector2f br = worldToWin(v, { float(v.hint.c2 + 1), float(v.hint.r2 + 1) });
+            hintBox_.setSize(br - tl);
+            hintBox_.setPosition(tl);
+            w.draw(hintBox_);
+        }
 
         /* ---- selection rectangle ---- */
-        if (dragging_) {
-            sf::Vector2f p0 = origin_ + sf::Vector2f(a_.x * cell_,
-                                                     a_.y * cell_);
-            sf::Vector2f p1 = origin_ + sf::Vector2f(b_.x * cell_,
-                                                     b_.y * cell_);
-            sf::Vector2f tl(std::min(p0.x, p1.x), std::min(p0.y, p1.y));
-            sf::Vector2f br(std::max(p0.x, p1.x) + cell_,
-                            std::max(p0.y, p1.y) + cell_);
-
-            sf::RectangleShape outline(br - tl);
-            outline.setPosition(tl);
-            outline.setFillColor(sf::Color::Transparent);
-            outline.setOutlineThickness(3.f);
-            outline.setOutlineColor(sf::Color::Yellow);
-            w.draw(outline);
+        if (v.dragging) {
+            sf::Vector2f tl = worldToWin(v, { float(v.sel.c1),     float(v.sel.r1) });
+            sf::Vector2f br = worldToWin(v, { float(v.sel.c2 + 1), float(v.sel.r2 + 1) });
+
+            selBox_.setSize(br - tl);
+            selBox_.setPosition(tl);
+            selBox_.setOutlineColor(v.selSum == v.target ? sf::Color::Green
+                                                   : sf::Color::Yellow);
+            w.draw(selBox_);
+
+            /* running sum, pinned above the rectangle's top-left */
+            sumText_.set("%d", v.selSum);
+            sumText_.setFillColor(selBox_.getOutlineColor());
+            sumText_.setPosition(tl.x, std::max(0.f, tl.y - 30.f));
+            w.draw(sumText_);
         }
 
         /* ---- HUD: score + timer ---- */
-        sf::Text hud; hud.setFont(font_); hud.setCharacterSize(26);
-        int secs = int(timeLeft_ < 0 ? 0 : timeLeft_);
-        int mm = secs / 60, ss = secs % 60;
-        std::ostringstream oss;
-        oss << "Score " << score_ << "   "
-            << std::setw(2) << std::setfill('0') << mm << ':'
-            << std::setw(2) << ss;
-        hud.setString(oss.str());
-        hud.setOrigin(hud.getLocalBounds().width, 0);
-        hud.setPosition(w.getSize().x - 10.f, 10.f);
-        w.draw(hud);
-
-        /* ---- optional FPS ---- */
-        if (set_.showFPS) {
-            sf::Text ft; ft.setFont(font_); ft.setCharacterSize(18);
-            ft.setString(std::to_string(
-                              static_cast<int>(fpsSmooth_ + 0.5f)) + " FPS");
-            ft.setOrigin(ft.getLocalBounds().width, 0);
-            ft.setPosition(w.getSize().x - 10.f, 42.f);
-            w.draw(ft);
+        hud_.set("Score %d   Moves %d   %02d:%02d",
+                 v.score, v.moves, v.secs / 60, v.secs % 60);
+        hud_.setOrigin(hud_.getLocalBounds().width, 0);
+        hud_.setPosition(w.getSize().x - 10.f, 10.f);
+        w.draw(hud_);
+
+        /* ---- early finish ---- */
+        if (v.finished) {
+            doneText_.set("No moves left  +%d bonus", v.bonus);
+            sf::FloatRect b = doneText_.getLocalBounds();
+            doneText_.setOrigin(b.left + b.width / 2.f, b.top + b.height / 2.f);
+            doneText_.setPosition(v.win.x / 2.f, v.win.y / 2.f);
+            w.draw(doneText_);
+        }
+
+        /* ---- board seed (top-left), to reproduce or rate a board ---- */
+        w.draw(seedText_);
+
+        /* ---- optional FPS, of the frames actually drawn ---- */
+        float dt = drawClock_.restart().asSeconds();
+        if (dt > 0.f) fpsSmooth_ = 0.9f * fpsSmooth_ + 0.1f * (1.f / dt);
+        if (v.showFPS) {
+            fpsText_.set("%d FPS", static_cast<int>(fpsSmooth_ + 0.5f));
+            fpsText_.setOrigin(fpsText_.getLocalBounds().width, 0);
+            fpsText_.setPosition(w.getSize().x - 10.f, 42.f);
+            w.draw(fpsText_);
         }
     }
 
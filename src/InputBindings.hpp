@@ -4,6 +4,7 @@
 struct InputBindings {
     sf::Keyboard::Key restart     = sf::Keyboard::Tab;
     sf::Keyboard::Key selectHold  = sf::Keyboard::Space;
+    sf::Keyboard::Key hint        = sf::Keyboard::H;
 };
 inline std::string keyName(sf::Keyboard::Key k) {
     using K = sf::Keyboard;
@@ -0,0 +1,345 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Input recording / replay
+ *  A session is reproducible from what enters the main loop: the board
+ *  pool's entropy (BoardPool hands out seeds deterministically), the
+ *  starting options and window size, and per frame the dt handed to
+ *  update() plus every window event, in order. Replaying that through
+ *  the same scenes rebuilds the same session, with or without drawing.
+ *
+ *  file layout (little endian):
+ *   header  "FBIN" u32 version | u64 entropy | i32 minMoves
+ *           | u32 flags (1 showFPS, 2 showProfiler) | u32 width | u32 height
+ *           | u32 board rows | u32 board cols        (version 1: classic board)
+ *           | u32 target | u32 values lo | hi << 8  (before 3: classic rules)
+ *   frame   varint dt µs | varint event count | events
+ *   event   u8 sf::Event type | varint µs since the frame began | payload
+ *  payloads use unsigned / zigzag varints; mouse positions are deltas
+ *  against the previous mouse position, so a drag costs ~4 bytes per
+ *  move. The stream is flushed once a second and whenever input
+ *  arrived, so a crash loses at most a second of idle frames.
+ * ------------------------------------------------------------------ */
+#include <SFML/Window.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class InputLog {
+public:
+    static constexpr std::uint32_t VERSION = 3;
+    static constexpr std::size_t   HEADER  = 48;
+
+    struct Header {
+        std::uint64_t entropy      = 0;
+        std::int32_t  minMoves     = 0;
+        bool          showFPS      = false;
+        bool          showProfiler = false;
+        std::uint32_t width = 0, height = 0;
+        std::uint32_t rows  = 10, cols = 17;            // board size
+        std::uint32_t target = 10, lo = 1, hi = 9;      // rules
+    };
+
+    /* the same quantisation on both sides keeps update() bit-identical */
+    static std::uint32_t toMicros(float dt)
+    { return dt > 0.f ? std::uint32_t(dt * 1e6f + 0.5f) : 0u; }
+    static float fromMicros(std::uint32_t us) { return us / 1e6f; }
+
+    /* window and input events; joystick / touch / sensor events are not
+       used by any scene, MouseWheelMoved duplicates MouseWheelScrolled */
+    static bool recorded(std::uint32_t type)
+    { return type <= sf::Event::MouseLeft && type != sf::Event::MouseWheelMoved; }
+
+protected:
+    int mouseX_ = 0, mouseY_ = 0;           // delta base for positions
+
+    static std::uint32_t zig(std::int32_t v)
+    { return (std::uint32_t(v) << 1) ^ std::uint32_t(v >> 31); }
+    static std::int32_t  unzig(std::uint32_t v)
+    { return std::int32_t(v >> 1) ^ -std::int32_t(v & 1); }
+};
+
+/* ====================================================================== */
+class InputRecorder : public InputLog {
+    using clock = std::chrono::steady_clock;
+
+    std::FILE*                 f_ = nullptr;
+    std::vector<unsigned char> frame_, events_;
+    std::uint32_t              count_ = 0;
+    clock::time_point          begin_, flushed_;
+
+    void varint(std::vector<unsigned char>& b, std::uint32_t v)
+    {
+        while (v >= 0x80) { b.push_back(static_cast<unsigned char>(v | 0x80)); v >>= 7; }
+        b.push_back(static_cast<unsigned char>(v));
+    }
+
+    void position(int x, int y)
+    {
+        varint(events_, zig(x - mouseX_));
+        varint(events_, zig(y - mouseY_));
+        mouseX_ = x; mouseY_ = y;
+    }
+
+public:
+    InputRecorder() = default;
+    ~InputRecorder() { close(); }
+
+    InputRecorder(const InputRecorder&)            = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
+
+    bool open(const std::string& path, const Header& h)
+    {
+        close();
+        f_ = std::fopen(path.c_str(), "wb");
+        if (!f_) return false;
+        unsigned char b[HEADER] = {};
+        auto put = [&](std::size_t at, std::uint64_t v, int bytes) {
+            for (int i = 0; i < bytes; ++i) b[at + i] = static_cast<unsigned char>(v >> (8 * i));
+        };
+        std::memcpy(b, "FBIN", 4);
+        put(4,  VERSION, 4);
+        put(8,  h.entropy, 8);
+        put(16, std::uint32_t(h.minMoves), 4);
+        put(20, (h.showFPS ? 1u : 0u) | (h.showProfiler ? 2u : 0u), 4);
+        put(24, h.width, 4);
+        put(28, h.height, 4);
+        put(32, h.rows, 4);
+        put(36, h.cols, 4);
+        put(40, h.target, 4);
+        put(44, h.lo | h.hi << 8, 4);
+        bool ok = std::fwrite(b, 1, HEADER, f_) == HEADER && std::fflush(f_) == 0;
+        if (!ok) close();
+        flushed_ = begin_ = clock::now();
+        return ok;
+    }
+
+    bool recording() const { return f_ != nullptr; }
+
+    void close()
+    {
+        if (!f_) return;
+        std::fclose(f_);
+        f_ = nullptr;
+    }
+
+    /* start of a main-loop iteration; event times are relative to it */
+    void beginFrame() { begin_ = clock::now(); }
+
+    void event(const sf::Event& e)
+    {
+        if (!f_ || !recorded(e.type)) return;
+        std::uint32_t at = std::uint32_t(std::chrono::duration_cast<
+                               std::chrono::microseconds>(clock::now() - begin_).count());
+        events_.push_back(static_cast<unsigned char>(e.type));
+        varint(events_, at);
+        switch (e.type) {
+            case sf::Event::Resized:
+                varint(events_, e.size.width);
+                varint(events_, e.size.height);
+                break;
+            case sf::Event::TextEntered:
+                varint(events_, e.text.unicode);
+                break;
+            case sf::Event::KeyPressed:
+            case sf::Event::KeyReleased:
+                varint(events_, zig(e.key.code));
+                events_.push_back(static_cast<unsigned char>(
+                    (e.key.alt ? 1 : 0) | (e.key.control ? 2 : 0) |
+                    (e.key.shift ? 4 : 0) | (e.key.system ? 8 : 0)));
+                break;
+            case sf::Event::MouseWheelScrolled: {
+                std::uint32_t bits;
+                std::memcpy(&bits, &e.mouseWheelScroll.delta, 4);
+                events_.push_back(static_cast<unsigned char>(e.mouseWheelScroll.wheel));
+                varint(events_, bits);
+                position(e.mouseWheelScroll.x, e.mouseWheelScroll.y);
+                break;
+            }
+            case sf::Event::MouseButtonPressed:
+            case sf::Event::MouseButtonReleased:
+                events_.push_back(static_cast<unsigned char>(e.mouseButton.button));
+                position(e.mouseButton.x, e.mouseButton.y);
+                break;
+            case sf::Event::MouseMoved:
+                position(e.mouseMove.x, e.mouseMove.y);
+                break;
+            default:
+                break;                                   // no payload
+        }
+        ++count_;
+    }
+
+    /* close the frame with the dt handed to update() */
+    void frame(float dt)
+    {
+        if (!f_) return;
+        frame_.clear();
+        varint(frame_, toMicros(dt));
+        varint(frame_, count_);
+        bool input = count_ != 0;
+        bool ok = std::fwrite(frame_.data(), 1, frame_.size(), f_) == frame_.size() &&
+                  std::fwrite(events_.data(), 1, events_.size(), f_) == events_.size();
+        events_.clear();
+        count_ = 0;
+
+        clock::time_point now = clock::now();
+        if (ok && (input || now - flushed_ >= std::chrono::seconds(1))) {
+            ok = std::fflush(f_) == 0;
+            flushed_ = now;
+        }
+        if (!ok) close();                                // disk full: stop quietly
+    }
+};
+
+/* ====================================================================== */
+class InputReplay : public InputLog {
+    std::vector<unsigned char> data_;
+    std::size_t                pos_    = 0;
+    std::uint32_t              left_   = 0;     // events left in this frame
+    std::uint64_t              frames_ = 0, events_ = 0;
+    bool                       bad_    = false;
+    Header                     header_;
+
+    bool varint(std::uint32_t& v)
+    {
+        v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (pos_ >= data_.size()) return false;
+            unsigned char b = data_[pos_++];
+            v |= std::uint32_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) return true;
+        }
+        return false;
+    }
+
+    bool byte(std::uint32_t& v)
+    {
+        if (pos_ >= data_.size()) return false;
+        v = data_[pos_++];
+        return true;
+    }
+
+    bool position(int& x, int& y)
+    {
+        std::uint32_t dx, dy;
+        if (!varint(dx) || !varint(dy)) return false;
+        x = mouseX_ += unzig(dx);
+        y = mouseY_ += unzig(dy);
+        return true;
+    }
+
+public:
+    bool open(const std::string& path)
+    {
+        std::FILE* f = std::fopen(path.c_str(), "rb");
+        if (!f) return false;
+        std::fseek(f, 0, SEEK_END);
+        long n = std::ftell(f);
+        std::fseek(f, 0, SEEK_SET);
+        data_.resize(n > 0 ? std::size_t(n) : 0);
+        bool ok = data_.size() == std::fread(data_.data(), 1, data_.size(), f);
+        std::fclose(f);
+        if (!ok || data_.size() < 32 || std::memcmp(data_.data(), "FBIN", 4)) return false;
+
+        auto get = [&](std::size_t at, int bytes) {
+            std::uint64_t v = 0;
+            for (int i = 0; i < bytes; ++i) v |= std::uint64_t(data_[at + i]) << (8 * i);
+            return v;
+        };
+        std::uint32_t version = std::uint32_t(get(4, 4));
+        if (version < 1 || version > VERSION) return false;
+        std::size_t header = version == 1 ? 32 : version == 2 ? 40 : HEADER;
+        if (data_.size() < header) return false;
+        header_.entropy      = get(8, 8);
+        header_.minMoves     = std::int32_t(std::uint32_t(get(16, 4)));
+        header_.showFPS      = get(20, 4) & 1;
+        header_.showProfiler = get(20, 4) & 2;
+        header_.width        = std::uint32_t(get(24, 4));
+        header_.height       = std::uint32_t(get(28, 4));
+        if (version >= 2) {
+            header_.rows = std::uint32_t(get(32, 4));
+            header_.cols = std::uint32_t(get(36, 4));
+        }
+        if (version >= 3) {
+            header_.target = std::uint32_t(get(40, 4));
+            header_.lo     = std::uint32_t(get(44, 4)) & 0xff;
+            header_.hi     = std::uint32_t(get(44, 4)) >> 8 & 0xff;
+        }
+        pos_ = header;
+        return true;
+    }
+
+    const Header& header() const { return header_; }
+    std::uint64_t frames() const { return frames_; }
+    std::uint64_t events() const { return events_; }
+    bool          truncated() const { return bad_; }   // log ended mid-frame
+
+    /* next frame's dt; false at the end of the log. Any events left
+       unread in the previous frame are skipped.                      */
+    bool nextFrame(float& dt)
+    {
+        sf::Event skip;
+        std::uint32_t at;
+        while (left_ && nextEvent(skip, at)) {}
+        std::uint32_t us, n;
+        if (pos_ >= data_.size()) return false;
+        if (!varint(us) || !varint(n)) { bad_ = true; return false; }
+        dt    = fromMicros(us);
+        left_ = n;
+        ++frames_;
+        return true;
+    }
+
+    /* next event of the current frame and its µs offset into the frame */
+    bool nextEvent(sf::Event& e, std::uint32_t& at)
+    {
+        if (!left_) return false;
+        --left_;
+        std::uint32_t type, a, b;
+        if (!byte(type) || !recorded(type) || !varint(at)) { bad_ = true; left_ = 0; return false; }
+        e = sf::Event();
+        e.type = static_cast<sf::Event::EventType>(type);
+        bool ok = true;
+        switch (e.type) {
+            case sf::Event::Resized:
+                ok = varint(a) && varint(b);
+                e.size.width = a; e.size.height = b;
+                break;
+            case sf::Event::TextEntered:
+                ok = varint(a);
+                e.text.unicode = a;
+                break;
+            case sf::Event::KeyPressed:
+            case sf::Event::KeyReleased:
+                ok = varint(a) && byte(b);
+                e.key.code    = static_cast<sf::Keyboard::Key>(unzig(a));
+                e.key.alt     = b & 1;
+                e.key.control = b & 2;
+                e.key.shift   = b & 4;
+                e.key.system  = b & 8;
+                break;
+            case sf::Event::MouseWheelScrolled:
+                ok = byte(a) && varint(b) &&
+                     position(e.mouseWheelScroll.x, e.mouseWheelScroll.y);
+                e.mouseWheelScroll.wheel = static_cast<sf::Mouse::Wheel>(a);
+                std::memcpy(&e.mouseWheelScroll.delta, &b, 4);
+                break;
+            case sf::Event::MouseButtonPressed:
+            case sf::Event::MouseButtonReleased:
+                ok = byte(a) && position(e.mouseButton.x, e.mouseButton.y);
+                e.mouseButton.button = static_cast<sf::Mouse::Button>(a);
+                break;
+            case sf::Event::MouseMoved:
+                ok = position(e.mouseMove.x, e.mouseMove.y);
+                break;
+            default:
+                break;
+        }
+        if (!ok) { bad_ = true; left_ = 0; return false; }
+        ++events_;
+        return true;
+    }
+};
@@ -0,0 +1,51 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  sf::Text for values that change while the scene runs (score, clock,
+ *  FPS, …), rewritten without touching the heap
+ *  – set() formats into a stack buffer and copies the characters into
+ *    a kept sf::String; sf::Text copies that into its own string and
+ *    rebuilds its quads only if it changed, all of them reusing their
+ *    capacity once grown
+ *  – prewarm() rasterises glyphs up front: the first use of a glyph
+ *    grows the font's glyph table and page texture, so a digit seen
+ *    for the first time would otherwise allocate mid-round. Like any
+ *    glyph lookup or text measurement it needs a GL context, so it is
+ *    called from draw(): a headless replay builds scenes, never draws
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <cstdio>
+
+class LiveText : public sf::Text {
+    sf::String str_;
+
+public:
+    LiveText() = default;
+    LiveText(const sf::Font& font, unsigned size) { setFont(font); setCharacterSize(size); }
+
+    template <class... Args>
+    void set(const char* fmt, Args... args)
+    {
+        char buf[128];
+        const char* s = fmt;
+        if constexpr (sizeof...(Args) > 0) {
+            std::snprintf(buf, sizeof buf, fmt, args...);
+            s = buf;
+        }
+        str_.clear();
+        for (; *s; ++s) str_ += sf::String(sf::Uint32(static_cast<unsigned char>(*s)));
+        setString(str_);
+    }
+
+    /* glyphs `chars` at this text's size and outline, fill and outline */
+    void prewarm(const char* chars = "0123456789") const
+    {
+        const sf::Font* f = getFont();
+        if (!f) return;
+        for (const char* c = chars; *c; ++c) {
+            f->getGlyph(sf::Uint32(static_cast<unsigned char>(*c)), getCharacterSize(), false);
+            if (getOutlineThickness() > 0.f)
+                f->getGlyph(sf::Uint32(static_cast<unsigned char>(*c)), getCharacterSize(),
+                            false, getOutlineThickness());
+        }
+    }
+};
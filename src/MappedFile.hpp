@@ -0,0 +1,74 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Read-only memory-mapped file (RAII)
+ *  – POSIX mmap / Win32 file mapping
+ *  – empty or missing files map to { nullptr, 0 }
+ * ------------------------------------------------------------------ */
+#include <cstddef>
+#include <filesystem>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+class MappedFile {
+    const unsigned char* data_ = nullptr;
+    std::size_t          size_ = 0;
+
+public:
+    explicit MappedFile(const std::filesystem::path& p)
+    {
+#ifdef _WIN32
+        HANDLE f = CreateFileW(p.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (f == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER sz;
+        if (GetFileSizeEx(f, &sz) && sz.QuadPart > 0) {
+            HANDLE m = CreateFileMappingW(f, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (m) {
+                data_ = static_cast<const unsigned char*>(
+                            MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0));
+                if (data_) size_ = std::size_t(sz.QuadPart);
+                CloseHandle(m);                  // the view keeps it alive
+            }
+        }
+        CloseHandle(f);
+#else
+        int fd = ::open(p.c_str(), O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* m = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                data_ = static_cast<const unsigned char*>(m);
+                size_ = std::size_t(st.st_size);
+            }
+        }
+        ::close(fd);                             // the mapping keeps it alive
+#endif
+    }
+
+    ~MappedFile()
+    {
+        if (!data_) return;
+#ifdef _WIN32
+        UnmapViewOfFile(data_);
+#else
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    }
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    std::size_t          size() const { return size_; }
+};
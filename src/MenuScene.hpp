@@ -1,27 +1,83 @@
 #pragma once
+#include <sstream>
 #include "Scene.hpp"
 #include "Button.hpp"
+#include "StaticLayer.hpp"
+#include "Settings.hpp"
+#include "core/BoardPool.hpp"
 
 class MenuScene : public Scene {
     sf::Font& font_;
-    Button    play_, config_;
+    Settings& set_;
+    Button    play_, config_, arena_, rules_;
     SceneID   next_ = SceneID::None;
+    sf::Text  stats_;                    // best overall / today, round count
+    sf::Text  rulesText_;                // what the picked preset asks for
+    StaticLayer layer_;                  // buttons + stats, painted once
+
+    void refreshRules() {
+        int p = presetOf(set_.rules);
+        const Rules& r = set_.rules;
+        std::ostringstream ss;
+        ss << "Sum " << r.target << ", values " << r.lo << '-' << r.hi
+           << ", " << r.rows << " x " << r.cols;
+        if (r != Classic::RULES) ss << "\n(not on the leaderboard)";
+        rules_.setLabel(p < 0 ? "Custom" : PRESETS[p].name);
+        rulesText_.setString(ss.str());
+        layer_.invalidate();
+        dirty_ = true;
+    }
+
+    /* next preset, on its own board (a marathon size is dropped); the
+       board filter keeps its step, measured on the new rules            */
+    void cycleRules() {
+        int p = presetOf(set_.rules);
+        const Rules old = set_.rules;
+        set_.rules    = PRESETS[(p + 1) % PRESET_COUNT].rules;
+        set_.minMoves = rescaleFilter(old, set_.rules, set_.minMoves);
+        refreshRules();
+    }
 
 public:
-    MenuScene(sf::Font& f)
-    : font_(f),
+    MenuScene(sf::Font& f, Settings& s)
+    : font_(f), set_(s),
       play_  (f, "Play",   {60.f, 60.f}, {220.f, 70.f}),
-      config_(f, "Config", {60.f,160.f}, {220.f, 70.f}) {}
+      config_(f, "Config", {60.f,160.f}, {220.f, 70.f}),
+      arena_ (f, "Arena",  {60.f,260.f}, {220.f, 70.f}),
+      rules_ (f, "",       {320.f,60.f}, {260.f, 70.f})
+    {
+        const ScoreStore& h = s.history;
+        std::ostringstream ss;
+        auto best  = h.top(1);
+        std::int64_t day = ScoreStore::localMidnight(ScoreStore::now());   // the player's "today"
+        auto today = h.topBetween(day, ScoreStore::localMidnight(day, 1), 1);
+        ss << "Best:  "  << (best.empty()  ? 0 : h.at(best[0]).score)  << '\n'
+           << "Today: "  << (today.empty() ? 0 : h.at(today[0]).score) << '\n'
+           << "Rounds: " << h.size();
+        stats_.setFont(font_);
+        stats_.setCharacterSize(22);
+        stats_.setString(ss.str());
+        stats_.setPosition(60.f, 370.f);
+        rulesText_.setFont(font_);
+        rulesText_.setCharacterSize(18);
+        rulesText_.setPosition(320.f, 140.f);
+        refreshRules();
+    }
 
     void handleEvent(const sf::Event& e) override {
         if (e.type==sf::Event::MouseButtonPressed && e.mouseButton.button==sf::Mouse::Left) {
             sf::Vector2f p{float(e.mouseButton.x), float(e.mouseButton.y)};
             if      (play_.contains(p))   next_ = SceneID::Game;
             else if (config_.contains(p)) next_ = SceneID::Config;
+            else if (arena_.contains(p))  next_ = SceneID::Arena;
+            else if (rules_.contains(p))  cycleRules();
         }
     }
     void update(float) override {}
-    void draw(sf::RenderWindow& w) override { play_.draw(w); config_.draw(w); }
+    void draw(sf::RenderTarget& w) override
+    { layer_.draw(w, [&](sf::RenderTarget& t) {
+          play_.draw(t); config_.draw(t); arena_.draw(t); rules_.draw(t);
+          t.draw(stats_); t.draw(rulesText_); }); }
 
     SceneID next() const override { return next_; }
     void    resetNext()    override { next_ = SceneID::None; }
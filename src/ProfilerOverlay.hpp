@@ -0,0 +1,79 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Profiler overlay (bottom-left corner)
+ *  – p50 / p95 / p99 / worst frame time over the last GRAPH frames,
+ *    and the median input-to-present lag of frames that had input
+ *  – frame-time graph, one bar per frame, stacked by phase, with
+ *    guide lines at 60 Hz and 30 Hz frame budgets
+ *  – built with FRUITBOX_TRACK_ALLOCS: heap allocations per frame by
+ *    phase, averaged over the same frames
+ *  Draws without allocating, so it does not disturb what it measures.
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <algorithm>
+
+#include "FrameProfiler.hpp"
+#include "LiveText.hpp"
+
+class ProfilerOverlay {
+    static constexpr std::size_t GRAPH  = 240;        // frames shown
+    static constexpr float       HEIGHT = 120.f;      // px for SCALE ms
+    static constexpr float       SCALE  = 50.f;       // ms at the top
+
+    sf::VertexArray bars_ { sf::Quads };
+    LiveText        stats_, allocs_;
+
+public:
+    void draw(sf::RenderTarget& w, const sf::Font& font, const FrameProfiler& prof)
+    {
+        const sf::Color phaseCol[FrameProfiler::PhaseCount] = {
+            sf::Color(90, 160, 255), sf::Color(120, 220, 120),
+            sf::Color(255, 170, 60), sf::Color(150, 150, 150) };
+
+        const float x0 = 10.f, y0 = w.getSize().y - 10.f;   // graph baseline
+        const float px = HEIGHT / SCALE;                     // px per ms
+        std::size_t n  = std::size_t(std::min<std::uint64_t>(prof.frames(), GRAPH));
+
+        /* ---- background + stacked bars, newest on the right ---- */
+        bars_.clear();
+        auto quad = [&](float l, float t, float r, float b, sf::Color c) {
+            bars_.append({ { l, t }, c }); bars_.append({ { r, t }, c });
+            bars_.append({ { r, b }, c }); bars_.append({ { l, b }, c });
+        };
+        quad(x0, y0 - HEIGHT, x0 + GRAPH * 2.f, y0, sf::Color(0, 0, 0, 170));
+        for (std::size_t i = 0; i < n; ++i) {
+            const FrameProfiler::Frame& f = prof.recent(i);
+            float x = x0 + (GRAPH - 1 - i) * 2.f, y = y0;
+            for (int p = 0; p < FrameProfiler::PhaseCount; ++p) {
+                float h = std::min(f.dur[p] / 1000.f * px, y - (y0 - HEIGHT));
+                quad(x, y - h, x + 2.f, y, phaseCol[p]);
+                y -= h;
+            }
+        }
+        for (float ms : { 1000.f / 60.f, 1000.f / 30.f })
+            quad(x0, y0 - ms * px, x0 + GRAPH * 2.f, y0 - ms * px + 1.f,
+                 sf::Color(255, 255, 255, 120));
+        w.draw(bars_);
+
+        /* ---- percentiles ---- */
+        FrameProfiler::Stats s = prof.stats(GRAPH);
+        stats_.setFont(font);
+        stats_.setCharacterSize(16);
+        stats_.set("p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms   input lag %.1f ms",
+                   double(s.p50), double(s.p95), double(s.p99), double(s.worst), double(s.lag));
+        stats_.setPosition(x0, y0 - HEIGHT - 24.f);
+        w.draw(stats_);
+
+#ifdef FRUITBOX_TRACK_ALLOCS
+        /* ---- allocations per frame ---- */
+        allocs_.setFont(font);
+        allocs_.setCharacterSize(16);
+        allocs_.set("allocs/frame  events %.1f  update %.1f  draw %.1f  present %.1f   %.0f B",
+                    double(s.allocs[FrameProfiler::Events]), double(s.allocs[FrameProfiler::Update]),
+                    double(s.allocs[FrameProfiler::Draw]),   double(s.allocs[FrameProfiler::Present]),
+                    double(s.bytes));
+        allocs_.setPosition(x0, y0 - HEIGHT - 46.f);
+        w.draw(allocs_);
+#endif
+    }
+};
@@ -0,0 +1,159 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Render thread (--render-thread)
+ *  – the window's GL context moves here with setActive(): the main
+ *    thread lets go of it in start(), this thread lets go when it stops
+ *  – the main thread polls events and updates the scene; after each
+ *    publish it calls frame(), which wakes this thread to draw and
+ *    present, vsync and frame cap included, so however long a frame
+ *    takes, no input waits behind it
+ *  – frames coalesce: whatever was published while this thread was
+ *    busy is drawn once, newest state only
+ *  – snapshot scenes (Scene::snapshots()) are drawn while the update
+ *    thread carries on; for the others, and to swap scenes, that
+ *    thread holds mutex(), and this one draws only while it is free
+ *  – pacing settings are applied here: vsync is set by the thread
+ *    that has the context
+ *  – profiler frames are this thread's frames; input lag runs from the
+ *    stamp handed to frame() to the present that shows it
+ *  The profiler belongs to this thread from start() until it stops.
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "Scene.hpp"
+#include "Settings.hpp"
+#include "FramePacer.hpp"
+#include "FrameProfiler.hpp"
+#include "ProfilerOverlay.hpp"
+
+class RenderThread {
+public:
+    using clock = std::chrono::steady_clock;
+
+private:
+    sf::RenderWindow&       win_;
+    const sf::Font&         font_;
+    const Settings&         set_;
+    FrameProfiler&          prof_;
+    std::function<void()>   firstPresent_;      // once, on this thread
+
+    std::mutex              sceneM_;            // scene_; non-snapshot scenes
+    Scene*                  scene_ = nullptr;
+
+    std::mutex              wakeM_;             // everything below up to thread_
+    std::condition_variable wakeCv_;
+    bool                    pending_ = false;   // published, not drawn yet
+    bool                    stop_    = false;
+    bool                    input_   = false;   // ... and it holds input
+    clock::time_point       inputAt_;           // that arrived this early
+
+    FramePacer              pacer_;
+    Pacing                  pacing_ = Pacing::VSync;
+    int                     cap_    = -1;
+    ProfilerOverlay         overlay_;
+    std::thread             thread_;
+
+    void applyPacing()                          // sceneM_ held
+    {
+        if (set_.pacing == pacing_ && set_.frameCap == cap_) return;
+        pacing_ = set_.pacing;
+        cap_    = set_.frameCap;
+        win_.setVerticalSyncEnabled(pacing_ == Pacing::VSync);
+        pacer_.setRate(pacing_ == Pacing::Limit ? cap_ : 0);
+    }
+
+    void loop()
+    {
+        win_.setActive(true);
+        bool first = true;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(wakeM_);
+                wakeCv_.wait(lk, [&] { return pending_ || stop_; });
+                if (stop_) break;
+            }
+            { std::lock_guard<std::mutex> lk(sceneM_); applyPacing(); }
+            pacer_.waitToSample();              // Pacing::Limit: draw late
+
+            prof_.beginFrame();
+            {
+                std::lock_guard<std::mutex> lk(wakeM_);
+                pending_ = false;
+                if (input_) prof_.arrived(inputAt_);
+                input_ = false;
+            }
+            {
+                std::lock_guard<std::mutex> lk(sceneM_);
+                prof_.mark(FrameProfiler::Events);      // waiting for the scene
+                win_.clear(sf::Color::Black);
+                if (scene_) scene_->draw(win_);
+                if (set_.showProfiler) overlay_.draw(win_, font_, prof_);
+            }
+            prof_.mark(FrameProfiler::Draw);
+
+            win_.display();                     // includes the vsync wait
+            prof_.mark(FrameProfiler::Present);
+            pacer_.presented();
+            prof_.endFrame();
+
+            if (first && firstPresent_) firstPresent_();
+            first = false;
+        }
+        win_.setActive(false);
+    }
+
+public:
+    RenderThread(sf::RenderWindow& w, const sf::Font& f, const Settings& s,
+                 FrameProfiler& p, std::function<void()> firstPresent = {})
+        : win_(w), font_(f), set_(s), prof_(p), firstPresent_(std::move(firstPresent)) {}
+
+    ~RenderThread() { stop(); }
+
+    RenderThread(const RenderThread&)            = delete;
+    RenderThread& operator=(const RenderThread&) = delete;
+
+    /* from the thread that holds the window's context */
+    void start(Scene* s)
+    {
+        scene_ = s;
+        win_.setActive(false);
+        thread_ = std::thread([this] { loop(); });
+    }
+
+    void stop()
+    {
+        if (!thread_.joinable()) return;
+        { std::lock_guard<std::mutex> lk(wakeM_); stop_ = true; }
+        wakeCv_.notify_one();
+        thread_.join();
+    }
+
+    /* update thread: held while it touches a scene that does not
+       snapshot, and around setScene()                                */
+    std::mutex& mutex() { return sceneM_; }
+    void setScene(Scene* s) { scene_ = s; }
+
+    /* something new was published; call after publish() */
+    void frame()
+    {
+        { std::lock_guard<std::mutex> lk(wakeM_); pending_ = true; }
+        wakeCv_.notify_one();
+    }
+
+    /* ... and it includes input that arrived at `at` */
+    void frame(clock::time_point at)
+    {
+        {
+            std::lock_guard<std::mutex> lk(wakeM_);
+            pending_ = true;
+            if (!input_ || at < inputAt_) inputAt_ = at;
+            input_ = true;
+        }
+        wakeCv_.notify_one();
+    }
+};
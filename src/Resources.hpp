@@ -0,0 +1,19 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Files compiled into the binary
+ *  – everything listed in EMBED (CMakeLists.txt) is turned into a byte
+ *    array at build time by cmake/EmbedResources.cmake, so the game
+ *    starts from any working directory and never waits on the disk for
+ *    its assets
+ *  – load with the loadFromMemory() of the SFML type; the bytes live
+ *    for the whole run, as sf::Font::loadFromMemory requires
+ * ------------------------------------------------------------------ */
+#include <cstddef>
+
+struct Resource {
+    const unsigned char* data;
+    std::size_t          size;
+};
+
+/* by path under resources/, e.g. "arial.ttf"; data is null if absent */
+Resource resource(const char* name);
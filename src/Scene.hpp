@@ -1,16 +1,38 @@
 #pragma once
 #include <SFML/Graphics.hpp>
 
-enum class SceneID { None, Menu, Game, Config, Exit };
+enum class SceneID { None, Menu, Game, Config, Arena, Exit };
 
 class Scene {
+protected:
+    bool dirty_ = true;                  // something visible changed
+
 public:
     virtual ~Scene() = default;
     virtual void handleEvent(const sf::Event& e) = 0;
     virtual void update(float dt)                = 0;
-    virtual void draw(sf::RenderWindow& w)       = 0;
+    virtual void draw(sf::RenderTarget& w)       = 0;
 
     virtual SceneID next()  const = 0;   // request a transition
     virtual void    resetNext()    = 0;   // clear that request
+
+    /* ---- idle rendering ----
+       wakeAfter(): seconds the scene can sleep without input before it
+       needs another update+draw; 0 = every frame, FOREVER = input only */
+    static constexpr float FOREVER = -1.f;
+    virtual float wakeAfter() const { return FOREVER; }
+
+    /* ---- drawing from a snapshot ----
+       publish() runs before every draw(), on the thread that updates.
+       A scene whose snapshots() is true copies there everything draw()
+       reads, so with --render-thread its draw() runs beside
+       handleEvent() / update(); the others are drawn while the update
+       thread holds off (RenderThread::lock())                         */
+    virtual bool snapshots() const { return false; }
+    virtual void publish() {}
+
+    bool dirty() const { return dirty_; }
+    void markDirty()   { dirty_ = true;  }
+    void markDrawn()   { dirty_ = false; }
 };
 
@@ -1,12 +1,70 @@
 #pragma once
+/* --------------------------------------------------------------------
+ *  Round history – every round ever played, human or simulated
+ *
+ *  on disk (in dataPath()):
+ *   rounds.log  journal; one fixed-size CRC-checked record per round,
+ *               appended and fsync'ed the moment the round ends; a
+ *               torn tail is cut off before the next append
+ *   rounds.col  columnar blocks; every FOLD_AT journal records (or one
+ *               bulk import) become one block whose columns are stored
+ *               contiguously, so loading is a mapped scan + memcpy
+ *   A block remembers the id of the journal it was folded from; the
+ *   journal is replaced only after the block is durable, so a crash in
+ *   between is detected on load instead of duplicating rounds.
+ *
+ *  in memory: the same columns (structure of arrays) plus indexes
+ *   – score buckets            → top-N overall, O(N + distinct scores)
+ *   – rounds per UTC day       → top-N of one day, partial sort of that day;
+ *                                top-N of a time range (a local calendar
+ *                                day) from the UTC days it touches
+ *   – best round per seed      → O(1)
+ *
+ *  layout (little endian; columns in host order, i.e. little endian on
+ *  every supported platform):
+ *   journal header  "FBRJ" u32 version | u64 journal id
+ *   journal record  u64 seed | i64 time | i32 score | i32 moves
+ *                   | i32 duration ms | u32 crc32(previous 28 bytes)
+ *   block header    "FBCB" u32 count | u64 journal id | u32 crc32(columns)
+ *                   | u32 0
+ *   block columns   i32 score[n] | i32 moves[n] | i32 duration[n]
+ *                   | i64 time[n] | u64 seed[n]
+ * ------------------------------------------------------------------ */
 #include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
 #include <fstream>
+#include <random>
+#include <sstream>
 #include <filesystem>
+#include <unordered_map>
+
+#include "MappedFile.hpp"
+
+#ifdef _WIN32
+#  include <io.h>
+#endif
 
 namespace fs = std::filesystem;
 
+/* one finished round */
+struct RoundRecord {
+    std::int32_t  score      = 0;
+    std::int32_t  moves      = 0;       // successful selections
+    std::int32_t  durationMs = 0;       // time actually played
+    std::int64_t  time       = 0;       // unix seconds at the end, 0 = unknown
+    std::uint64_t seed       = 0;       // board seed, 0 = unknown
+};
+
 class ScoreStore {
 public:
+    static constexpr std::size_t   FOLD_AT = 4096;          // journal records per block
+    static constexpr std::uint32_t VERSION = 2;
+
     static fs::path dataPath() {
 #ifdef _WIN32
         const char* base = std::getenv("APPDATA");            // e.g. C:\Users\Ed\AppData\Roaming
@@ -19,27 +77,384 @@ public:
 #endif
     }
 
-    static fs::path filePath() { return dataPath() / "scores.txt"; }
+    static std::int64_t now()              { return std::int64_t(std::time(nullptr)); }
+    static std::int32_t dayOf(std::int64_t t)
+    { return std::int32_t(t >= 0 ? t / 86400 : (t - 86399) / 86400); }
 
-    /* load existing scores (sorted high→low) */
-    static std::vector<int> load() {
-        std::vector<int> v;
-        std::ifstream f(filePath());
-        int x;
-        while (f >> x) v.push_back(x);
-        std::sort(v.begin(), v.end(), std::greater<int>());
-        return v;
+    /* start of the local calendar day `days` after the one holding t
+       (mktime picks the DST offset, so days can be 23 or 25 h long)    */
+    static std::int64_t localMidnight(std::int64_t t, int days = 0)
+    {
+        std::time_t tt = std::time_t(t);
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &tt);
+#else
+        localtime_r(&tt, &tm);
+#endif
+        tm.tm_mday += days;
+        tm.tm_hour = tm.tm_min = tm.tm_sec = 0;
+        tm.tm_isdst = -1;
+        return std::int64_t(std::mktime(&tm));
+    }
+
+private:
+    static constexpr std::size_t JHEADER = 16, JRECORD = 32, BHEADER = 24;
+
+    fs::path                    dir_;              // empty: memory only
+    std::uint64_t               journalId_ = 0;    // 0: no journal file yet
+    std::size_t                 journaled_ = 0;    // records in the journal
+    std::size_t                 folded_    = 0;    // records in rounds.col
+    std::uintmax_t              colGood_   = 0;    // bytes of intact blocks
+
+    /* columns */
+    std::vector<std::int32_t>   score_, moves_, duration_;
+    std::vector<std::int64_t>   time_;
+    std::vector<std::uint64_t>  seed_;
+
+    /* indexes */
+    std::vector<std::vector<std::uint32_t>>                      byScore_;
+    std::unordered_map<std::int32_t, std::vector<std::uint32_t>> byDay_;
+    std::unordered_map<std::uint64_t, std::uint32_t>             bestBySeed_;
+
+public:
+    ScoreStore() = default;                        // memory only
+
+    explicit ScoreStore(const fs::path& dir) : dir_(dir)
+    {
+        std::error_code ec;
+        bool fresh = !fs::exists(colPath(), ec) && !fs::exists(journalPath(), ec);
+        std::uint64_t lastFold = loadBlocks();
+        loadJournal(lastFold);
+        if (fresh) importLegacy();
+        if (journaled_ >= FOLD_AT) fold();
+    }
+
+    ScoreStore(ScoreStore&&)            = default;
+    ScoreStore& operator=(ScoreStore&&) = default;
+
+    fs::path colPath()     const { return dir_ / "rounds.col"; }
+    fs::path journalPath() const { return dir_ / "rounds.log"; }
+
+    /* ------------- writing ------------------------------------------ */
+
+    /* durably log one finished round: one journal record, O(1) */
+    bool add(const RoundRecord& r)
+    {
+        push(r);
+        if (dir_.empty()) return true;
+        bool ok = appendJournal(r);
+        if (ok && journaled_ >= FOLD_AT) ok = fold();
+        return ok;
+    }
+
+    /* many rounds at once (simulations): one columnar block, no journal */
+    bool addBulk(const std::vector<RoundRecord>& v)
+    {
+        score_.reserve(score_.size() + v.size());
+        moves_.reserve(moves_.size() + v.size());
+        duration_.reserve(duration_.size() + v.size());
+        time_.reserve(time_.size() + v.size());
+        seed_.reserve(seed_.size() + v.size());
+        for (const RoundRecord& r : v) push(r);
+        return dir_.empty() || fold();
+    }
+
+    /* move everything not yet in rounds.col into a new block */
+    bool fold()
+    {
+        if (dir_.empty() || folded_ == size()) return true;
+        std::error_code ec;
+        fs::create_directories(dir_, ec);
+
+        std::size_t b = folded_, n = size() - folded_;
+        std::vector<unsigned char> buf(BHEADER + n * 28);
+        unsigned char* col = buf.data() + BHEADER;
+        auto column = [&](const void* src, std::size_t bytes) {
+            std::memcpy(col, src, bytes); col += bytes;
+        };
+        column(&score_[b],    n * 4);
+        column(&moves_[b],    n * 4);
+        column(&duration_[b], n * 4);
+        column(&time_[b],     n * 8);
+        column(&seed_[b],     n * 8);
+        std::memcpy(buf.data(), "FBCB", 4);
+        put(buf.data() + 4,  n, 4);
+        put(buf.data() + 8,  journalId_, 8);
+        put(buf.data() + 16, crc32(buf.data() + BHEADER, n * 28), 4);
+        put(buf.data() + 20, 0, 4);
+
+        /* drop a torn block first, then append and make it durable */
+        if (fs::exists(colPath(), ec) && fs::file_size(colPath(), ec) != colGood_)
+            fs::resize_file(colPath(), colGood_, ec);
+        std::FILE* f = std::fopen(colPath().string().c_str(), "ab");
+        if (!f) return false;
+        bool ok = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size() && sync(f);
+        ok = std::fclose(f) == 0 && ok;
+        if (!ok) return false;
+        colGood_ += buf.size();
+        folded_   = size();
+
+        /* the block covers the journal: start a new one */
+        return resetJournal();
+    }
+
+    /* ------------- queries ------------------------------------------ */
+
+    std::size_t size() const { return score_.size(); }
+
+    RoundRecord at(std::size_t i) const
+    { return { score_[i], moves_[i], duration_[i], time_[i], seed_[i] }; }
+
+    /* indexes of the n best rounds, best first (ties: oldest first) */
+    std::vector<std::uint32_t> top(std::size_t n) const
+    {
+        std::vector<std::uint32_t> out;
+        for (std::size_t s = byScore_.size(); s-- > 0 && out.size() < n; )
+            for (std::uint32_t i : byScore_[s]) {
+                if (out.size() == n) break;
+                out.push_back(i);
+            }
+        return out;
+    }
+
+    /* n best rounds that ended on the given UTC day (see dayOf) */
+    std::vector<std::uint32_t> topOnDay(std::int32_t day, std::size_t n) const
+    {
+        auto it = byDay_.find(day);
+        if (it == byDay_.end()) return {};
+        std::vector<std::uint32_t> out(std::min(n, it->second.size()));
+        std::partial_sort_copy(it->second.begin(), it->second.end(), out.begin(), out.end(),
+            [&](std::uint32_t a, std::uint32_t b) {
+                return score_[a] != score_[b] ? score_[a] > score_[b] : a < b;
+            });
+        return out;
+    }
+
+    /* n best rounds that ended in [from, to) (unix seconds), best first;
+       only the UTC days the range touches are visited                 */
+    std::vector<std::uint32_t> topBetween(std::int64_t from, std::int64_t to, std::size_t n) const
+    {
+        std::vector<std::uint32_t> in;
+        if (from >= to) return in;
+        for (std::int32_t d = dayOf(from), last = dayOf(to - 1); d <= last; ++d) {
+            auto it = byDay_.find(d);
+            if (it == byDay_.end()) continue;
+            for (std::uint32_t i : it->second)
+                if (time_[i] >= from && time_[i] < to) in.push_back(i);
+        }
+        std::vector<std::uint32_t> out(std::min(n, in.size()));
+        std::partial_sort_copy(in.begin(), in.end(), out.begin(), out.end(),
+            [&](std::uint32_t a, std::uint32_t b) {
+                return score_[a] != score_[b] ? score_[a] > score_[b] : a < b;
+            });
+        return out;
+    }
+
+    /* best round on this board; false if the seed was never played */
+    bool bestForSeed(std::uint64_t seed, RoundRecord& out) const
+    {
+        auto it = bestBySeed_.find(seed);
+        if (it == bestBySeed_.end()) return false;
+        out = at(it->second);
+        return true;
+    }
+
+private:
+    void push(const RoundRecord& r)
+    {
+        std::uint32_t i = std::uint32_t(size());
+        score_.push_back(r.score);
+        moves_.push_back(r.moves);
+        duration_.push_back(r.durationMs);
+        time_.push_back(r.time);
+        seed_.push_back(r.seed);
+        index(i);
+    }
+
+    void index(std::uint32_t i)
+    {
+        std::size_t s = std::size_t(std::max(0, score_[i]));
+        if (s >= byScore_.size()) byScore_.resize(s + 1);
+        byScore_[s].push_back(i);
+        byDay_[dayOf(time_[i])].push_back(i);
+        auto it = bestBySeed_.find(seed_[i]);          // find first: emplace
+        if (it == bestBySeed_.end()) bestBySeed_.emplace(seed_[i], i);   // allocates
+        else if (score_[i] > score_[it->second]) it->second = i;
+    }
+
+    /* ------------- loading ------------------------------------------ */
+
+    /* returns the journal id recorded by the last intact block */
+    std::uint64_t loadBlocks()
+    {
+        MappedFile m(colPath());
+        const unsigned char* p = m.data();
+        std::size_t off = 0;
+        std::uint64_t lastFold = 0;
+        while (m.size() - off >= BHEADER && !std::memcmp(p + off, "FBCB", 4)) {
+            std::size_t n = std::size_t(get(p + off + 4, 4));
+            if (m.size() - off - BHEADER < n * 28) break;                // torn
+            const unsigned char* col = p + off + BHEADER;
+            if (get(p + off + 16, 4) != crc32(col, n * 28)) break;      // damaged
+            std::size_t b = size();
+            auto column = [&](auto& v, std::size_t bytes) {
+                v.resize(b + n);
+                std::memcpy(&v[b], col, n * bytes); col += n * bytes;
+            };
+            column(score_, 4); column(moves_, 4); column(duration_, 4);
+            column(time_, 8);  column(seed_, 8);
+            lastFold = get(p + off + 8, 8);
+            off += BHEADER + n * 28;
+        }
+        colGood_ = off;
+        folded_  = size();
+
+        byDay_.reserve(size() / 64 + 16);
+        bestBySeed_.reserve(size());
+        for (std::uint32_t i = 0; i < size(); ++i) index(i);
+        return lastFold;
+    }
+
+    void loadJournal(std::uint64_t lastFold)
+    {
+        MappedFile m(journalPath());
+        if (m.size() < JHEADER || std::memcmp(m.data(), "FBRJ", 4) ||
+            get(m.data() + 4, 4) != VERSION)
+            return;
+        journalId_ = get(m.data() + 8, 8);
+        std::size_t n = (m.size() - JHEADER) / JRECORD;
+        journaled_ = n;
+        if (journalId_ == lastFold) {             // folded, crash before reset
+            resetJournal();
+            return;
+        }
+        for (const unsigned char* r = m.data() + JHEADER, *end = r + n * JRECORD;
+             r != end; r += JRECORD) {
+            if (get(r + 28, 4) != crc32(r, 28)) continue;      // damaged record
+            RoundRecord e;
+            e.seed       = get(r, 8);
+            e.time       = std::int64_t(get(r + 8, 8));
+            e.score      = std::int32_t(std::uint32_t(get(r + 16, 4)));
+            e.moves      = std::int32_t(std::uint32_t(get(r + 20, 4)));
+            e.durationMs = std::int32_t(std::uint32_t(get(r + 24, 4)));
+            push(e);
+        }
     }
 
-    /* append a new score and keep only top N (default 100) */
-    static void append(int score, std::vector<int>& vec, std::size_t limit = 100) {
-        vec.insert(std::upper_bound(vec.begin(), vec.end(), score, std::greater<int>()), score);
-        if (vec.size() > limit) vec.resize(limit);
+    /* earlier versions: scores.log (score, seed, time) and scores.txt */
+    void importLegacy()
+    {
+        std::vector<RoundRecord> v;
+        MappedFile m(dir_ / "scores.log");
+        if (m.size() >= 8 && !std::memcmp(m.data(), "FBSL", 4))
+            for (std::size_t off = 8; off + 24 <= m.size(); off += 24) {
+                const unsigned char* r = m.data() + off;
+                if (get(r + 20, 4) != crc32(r, 20)) continue;
+                RoundRecord e;
+                e.seed  = get(r, 8);
+                e.time  = std::int64_t(get(r + 8, 8));
+                e.score = std::int32_t(std::uint32_t(get(r + 16, 4)));
+                v.push_back(e);
+            }
+        else {
+            std::ifstream f(dir_ / "scores.txt");
+            std::string line;
+            while (std::getline(f, line)) {
+                std::istringstream in(line);
+                RoundRecord e;
+                if (!(in >> e.score)) continue;
+                in >> e.seed;
+                v.push_back(e);
+            }
+        }
+        if (!v.empty()) addBulk(v);
     }
 
-    static void save(const std::vector<int>& v) {
-        fs::create_directories(dataPath());
-        std::ofstream f(filePath(), std::ios::trunc);
-        for (int s : v) f << s << '\n';
+    /* ------------- journal ------------------------------------------ */
+
+    bool resetJournal()
+    {
+        std::random_device rd;
+        do journalId_ = (std::uint64_t(rd()) << 32) ^ rd() ^ std::uint64_t(now());
+        while (!journalId_);
+        journaled_ = 0;
+
+        std::error_code ec;
+        fs::create_directories(dir_, ec);
+        fs::path tmp = journalPath(); tmp += ".tmp";
+        std::FILE* f = std::fopen(tmp.string().c_str(), "wb");
+        if (!f) return false;
+        unsigned char h[JHEADER];
+        std::memcpy(h, "FBRJ", 4);
+        put(h + 4, VERSION, 4);
+        put(h + 8, journalId_, 8);
+        bool ok = std::fwrite(h, 1, JHEADER, f) == JHEADER && sync(f);
+        ok = std::fclose(f) == 0 && ok;
+        if (ok) fs::rename(tmp, journalPath(), ec);
+        return ok && !ec;
+    }
+
+    bool appendJournal(const RoundRecord& e)
+    {
+        std::error_code ec;
+        std::uintmax_t sz = fs::file_size(journalPath(), ec);
+        if (!journalId_ || ec || sz < JHEADER) {
+            if (!resetJournal()) return false;
+            sz = JHEADER;
+        }
+        /* drop a torn tail so records stay aligned */
+        if ((sz - JHEADER) % JRECORD)
+            fs::resize_file(journalPath(), sz - (sz - JHEADER) % JRECORD, ec);
+
+        unsigned char r[JRECORD];
+        put(r,      e.seed, 8);
+        put(r + 8,  std::uint64_t(e.time), 8);
+        put(r + 16, std::uint32_t(e.score), 4);
+        put(r + 20, std::uint32_t(e.moves), 4);
+        put(r + 24, std::uint32_t(e.durationMs), 4);
+        put(r + 28, crc32(r, 28), 4);
+
+        std::FILE* f = std::fopen(journalPath().string().c_str(), "ab");
+        if (!f) return false;
+        bool ok = std::fwrite(r, 1, JRECORD, f) == JRECORD && sync(f);
+        ok = std::fclose(f) == 0 && ok;
+        if (ok) ++journaled_;
+        return ok;
+    }
+
+    /* ------------- encoding ------------------------------------------ */
+
+    static std::uint32_t crc32(const unsigned char* p, std::size_t n) {
+        static const auto table = [] {
+            std::vector<std::uint32_t> t(256);
+            for (std::uint32_t i = 0; i < 256; ++i) {
+                std::uint32_t c = i;
+                for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[i] = c;
+            }
+            return t;
+        }();
+        std::uint32_t c = 0xFFFFFFFFu;
+        while (n--) c = table[(c ^ *p++) & 0xFF] ^ (c >> 8);
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    static void put(unsigned char* p, std::uint64_t v, int bytes) {
+        for (int i = 0; i < bytes; ++i) p[i] = (unsigned char)(v >> (8 * i));
+    }
+    static std::uint64_t get(const unsigned char* p, int bytes) {
+        std::uint64_t v = 0;
+        for (int i = 0; i < bytes; ++i) v |= std::uint64_t(p[i]) << (8 * i);
+        return v;
+    }
+
+    static bool sync(std::FILE* f) {
+        if (std::fflush(f) != 0) return false;
+#ifdef _WIN32
+        return _commit(_fileno(f)) == 0;
+#else
+        return ::fsync(fileno(f)) == 0;
+#endif
     }
 };
@@ -1,11 +1,21 @@
 #pragma once
-#include <vector>
 #include "ScoreStore.hpp"
+#include "core/Round.hpp"
+
+/* how frames are paced (see FramePacer.hpp) */
+enum class Pacing { VSync, Uncapped, Limit };
 
 struct Settings {
-    bool showFPS = false;
-    std::vector<int> scores;
+    bool showFPS  = false;
+    bool showProfiler = false;          // frame-time overlay
+    int  minMoves = 0;                  // board quality filter, 0 = off
+    Pacing pacing = Pacing::VSync;
+    int  frameCap = 240;                // Hz, with Pacing::Limit
+    Rules rules = Classic::RULES;       // preset (menu) and board size
+                                        // (config: classic or marathon)
+    ScoreStore history;                 // every round played, indexed;
+                                        // main() loads it off-thread at
+                                        // boot, otherwise memory only
 
-    Settings() : scores(ScoreStore::load()) {}          // ← load at boot
-    ~Settings()               { ScoreStore::save(scores); } // ← save on exit
+    /* rounds are logged as each one ends, so nothing is saved on exit */
 };
@@ -0,0 +1,107 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Startup timing (--startup-profile)
+ *  – main() marks the end of each startup step, the last one being
+ *    the first presented frame
+ *  – the time before main() (loader, shared libraries, static init)
+ *    comes from the OS: process creation time on Windows (100 ns),
+ *    /proc/self/stat on Linux (clock ticks, usually 10 ms); elsewhere
+ *    the report starts at the first mark's clock
+ *  – work on other threads is reported by its own duration plus the
+ *    time main() spent waiting for it, which is what startup paid
+ * ------------------------------------------------------------------ */
+#include <chrono>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#  ifndef NOMINMAX
+#    define NOMINMAX
+#  endif
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <ctime>
+#  include <fstream>
+#  include <sstream>
+#  include <unistd.h>
+#endif
+
+class StartupProfile {
+    using clock = std::chrono::steady_clock;
+
+    struct Step { std::string name; float ms; float waited; };  // waited < 0: main thread
+
+    clock::time_point last_ = clock::now();
+    float             before_;                    // ms before main(), < 0 unknown
+    std::vector<Step> steps_;
+
+    static float ms(clock::duration d)
+    { return std::chrono::duration<float, std::milli>(d).count(); }
+
+    /* ms from process creation until now, < 0 if the OS won't say */
+    static float sinceProcessStart()
+    {
+#ifdef _WIN32
+        FILETIME created, exited, kernel, user, now;
+        if (!GetProcessTimes(GetCurrentProcess(), &created, &exited, &kernel, &user))
+            return -1.f;
+        GetSystemTimeAsFileTime(&now);
+        auto ticks = [](const FILETIME& f) {
+            return (ULONGLONG(f.dwHighDateTime) << 32) | f.dwLowDateTime;
+        };
+        return float(ticks(now) - ticks(created)) / 1e4f;
+#elif defined(__linux__)
+        std::ifstream f("/proc/self/stat");
+        std::string s((std::istreambuf_iterator<char>(f)), std::istreambuf_iterator<char>());
+        std::size_t p = s.rfind(')');             // the command name may hold spaces
+        if (p == std::string::npos) return -1.f;
+        std::istringstream in(s.substr(p + 1));
+        std::string skip;
+        unsigned long long start = 0;
+        for (int field = 3; field < 22; ++field) in >> skip;     // starttime is field 22
+        if (!(in >> start)) return -1.f;
+        timespec now;
+        if (clock_gettime(CLOCK_BOOTTIME, &now)) return -1.f;   // the clock starttime uses
+        double up = now.tv_sec * 1e3 + now.tv_nsec / 1e6;
+        return float(up - start * 1e3 / double(sysconf(_SC_CLK_TCK)));
+#else
+        return -1.f;
+#endif
+    }
+
+public:
+    StartupProfile() : before_(sinceProcessStart()) {}
+
+    /* the step that just ended on the main thread */
+    void mark(const char* name)
+    {
+        clock::time_point now = clock::now();
+        steps_.push_back({ name, ms(now - last_), -1.f });
+        last_ = now;
+    }
+
+    /* a step that ran on another thread for `took`, main() waited `waited` */
+    void background(const char* name, clock::duration took, clock::duration waited)
+    {
+        steps_.push_back({ name, ms(took), ms(waited) });
+    }
+
+    void print(std::FILE* out) const
+    {
+        float total = before_ > 0.f ? before_ : 0.f;
+        std::fprintf(out, "startup                     step ms   total ms\n");
+        if (before_ >= 0.f)
+            std::fprintf(out, "  %-24s %9.1f  %9.1f\n", "before main()", before_, total);
+        for (const Step& s : steps_) {
+            if (s.waited >= 0.f) {                // already inside a main-thread step
+                std::fprintf(out, "  %-24s %9.1f  (main waited %.1f)\n",
+                             s.name.c_str(), s.ms, s.waited);
+                continue;
+            }
+            total += s.ms;
+            std::fprintf(out, "  %-24s %9.1f  %9.1f\n", s.name.c_str(), s.ms, total);
+        }
+    }
+};
@@ -0,0 +1,40 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Static layer: content painted once into an offscreen texture and
+ *  then blitted as a single sprite until invalidated. Sized to the
+ *  target's current view, so it lines up with what it replaces. The
+ *  texture is made on the first draw: constructing one opens SFML's GL
+ *  context, which a headless replay does not have.
+ * ------------------------------------------------------------------ */
+#include <SFML/Graphics.hpp>
+#include <memory>
+
+class StaticLayer {
+    std::unique_ptr<sf::RenderTexture> tex_;
+    sf::Sprite        sprite_;
+    sf::Vector2u      size_;
+    bool              valid_ = false;
+
+public:
+    void invalidate() { valid_ = false; }
+
+    /* paint(sf::RenderTarget&) runs only when the cache is stale */
+    template <class Paint>
+    void draw(sf::RenderTarget& w, Paint&& paint)
+    {
+        const sf::View& view = w.getView();
+        sf::Vector2u sz(unsigned(view.getSize().x), unsigned(view.getSize().y));
+        if (!valid_ || sz != size_) {
+            if (!tex_) tex_ = std::make_unique<sf::RenderTexture>();
+            if (sz != size_ && !tex_->create(sz.x, sz.y)) { paint(w); return; }
+            size_ = sz;
+            tex_->clear(sf::Color::Transparent);
+            paint(*tex_);
+            tex_->display();
+            sprite_.setTexture(tex_->getTexture(), true);
+            valid_ = true;
+        }
+        sprite_.setPosition(view.getCenter() - view.getSize() / 2.f);
+        w.draw(sprite_);
+    }
+};
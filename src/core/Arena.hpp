@@ -0,0 +1,196 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Bot arena: many classic rounds played at once by the greedy bot
+ *  – each board is one job on a WorkStealingPool; a run plays one
+ *    move (or starts the next round) and publishes a snapshot of the
+ *    board through a DoubleBuffer, so a reader never waits on a move
+ *  – Watch: a board moves every MOVE_SECS or so (jittered per board)
+ *    and its clock runs at that pace, then shows the result for
+ *    LINGER_SECS; between moves the job is parked and pump(), called
+ *    by the reader once a frame, hands due boards back to the pool
+ *  – FlatOut: boards run back to back on every worker (soak test),
+ *    spending MOVE_SECS of round time per move, like fruitbox_sim
+ *  – moves and rounds are counted per worker (no shared cache line
+ *    on the hot path) and summed on demand
+ *  Seeds are base + a global round counter through splitmix, so runs
+ *  are varied but every board is a valid classic board.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Bot.hpp"
+#include "DoubleBuffer.hpp"
+#include "WorkStealingPool.hpp"
+
+class Arena {
+public:
+    enum class Pace { Watch, FlatOut };
+
+    static constexpr float MOVE_SECS   = 0.35f;
+    static constexpr float LINGER_SECS = 2.f;
+
+    /* what a reader sees of one board */
+    struct View {
+        std::uint8_t  cells[Round::ROWS * Round::COLS] = {};  // value, 0 = cleared
+        Rect          last{ 0, 0, -1, -1 };                    // last move, empty = none
+        int           score = 0, moves = 0, ticksLeft = Round::LENGTH_TICKS;
+        bool          over = false;
+        std::uint32_t round = 0;                               // rounds this board began
+        std::uint64_t version = 0;                             // bumped per publish
+    };
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct alignas(64) Slot {
+        /* worker side: only the thread currently running the job */
+        Round              round;
+        Rect               last{ 0, 0, -1, -1 };
+        std::uint32_t      rounds  = 0;
+        std::uint64_t      version = 0;
+        bool               stale   = true;     // not published since it changed
+        std::int64_t       periodUs = 0;       // Watch: time between moves
+
+        std::atomic<std::int64_t> due{0};      // µs since epoch_, when parked
+        std::atomic<bool>         parked{false};
+        DoubleBuffer<View>        view;
+    };
+
+    struct alignas(64) Counter {
+        std::atomic<std::uint64_t> moves{0}, rounds{0};
+    };
+
+    const std::uint64_t              base_;
+    std::atomic<std::uint64_t>       nextRound_{0};
+    std::atomic<Pace>                pace_;
+    clock::time_point                epoch_ = clock::now();
+    std::vector<std::unique_ptr<Slot>> slots_;
+    std::vector<Counter>             counters_;
+    std::unique_ptr<WorkStealingPool> pool_;    // last: its threads use the above
+
+    std::int64_t nowUs() const
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+                   clock::now() - epoch_).count();
+    }
+
+    void begin(Slot& s, Counter& c)
+    {
+        std::uint64_t x = base_ + nextRound_.fetch_add(1, std::memory_order_relaxed);
+        s.round.reset(BoardGen::splitmix(x));
+        s.last = Rect{ 0, 0, -1, -1 };
+        ++s.rounds;
+        c.rounds.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool step(int job, int worker)
+    {
+        Slot&    s    = *slots_[std::size_t(job)];
+        Counter& c    = counters_[std::size_t(worker)];
+        bool     flat = pace_.load(std::memory_order_relaxed) == Pace::FlatOut;
+
+        if (!s.stale) {                        // the last state is out: advance
+            if (s.round.over()) begin(s, c);
+            else {
+                Rect m;
+                if (greedyMove(s.round, m)) {
+                    s.round.apply(m);
+                    s.last = m;
+                    c.moves.fetch_add(1, std::memory_order_relaxed);
+                    s.round.advance(flat ? std::int64_t(MOVE_SECS * 1e6) : s.periodUs);
+                } else {
+                    s.round.finish();          // no move left: time bonus
+                }
+            }
+            ++s.version;
+            s.stale = true;
+        }
+        if (s.view.publish([&](View& v) { fill(s, v); })) s.stale = false;
+        if (flat || s.stale) return true;      // the reader held it: retry soon
+
+        s.due.store(nowUs() + (s.round.over() ? std::int64_t(LINGER_SECS * 1e6) : s.periodUs),
+                    std::memory_order_relaxed);
+        s.parked.store(true, std::memory_order_release);
+        return false;
+    }
+
+    static void fill(const Slot& s, View& v)
+    {
+        const Board& b = s.round.board();
+        for (int r = 0; r < Round::ROWS; ++r)
+            for (int col = 0; col < Round::COLS; ++col)
+                v.cells[r * Round::COLS + col] =
+                    std::uint8_t(b.alive(r, col) ? b.value(r, col) : 0);
+        v.last      = s.last;
+        v.score     = s.round.score();
+        v.moves     = s.round.moves();
+        v.ticksLeft = s.round.ticksLeft();
+        v.over      = s.round.over();
+        v.round     = s.rounds;
+        v.version   = s.version;
+    }
+
+public:
+    /* threads = 0: one per hardware thread, less the caller's */
+    Arena(int boards, std::uint64_t entropy, Pace pace = Pace::Watch, int threads = 0)
+        : base_(entropy), pace_(pace)
+    {
+        int n = threads > 0 ? threads
+                            : std::max(1, int(std::thread::hardware_concurrency()) - 1);
+        counters_ = std::vector<Counter>(std::size_t(n));
+        for (int i = 0; i < boards; ++i) {
+            slots_.push_back(std::make_unique<Slot>());
+            Slot& s = *slots_.back();
+            std::uint64_t x = entropy + std::uint64_t(i) * 0x9e3779b97f4a7c15ull;
+            double jitter = 0.75 + 0.5 * double(BoardGen::splitmix(x) % 1000) / 1000.0;
+            s.periodUs = std::int64_t(MOVE_SECS * 1e6 * jitter);  // boards out of step
+            begin(s, counters_[0]);
+            s.parked.store(true, std::memory_order_relaxed);     // pump() starts it
+        }
+        pool_ = std::make_unique<WorkStealingPool>(
+            [this](int job, int worker) { return step(job, worker); }, n);
+    }
+
+    ~Arena() { pool_.reset(); }                // join before the slots go
+
+    int  boards()  const { return int(slots_.size()); }
+    int  threads() const { return pool_->size(); }
+    Pace pace()    const { return pace_.load(std::memory_order_relaxed); }
+    void setPace(Pace p) { pace_.store(p, std::memory_order_relaxed); }
+
+    /* reader, once a frame: hand boards that are due back to the pool */
+    void pump()
+    {
+        bool flat = pace() == Pace::FlatOut;
+        std::int64_t now = nowUs();
+        for (int i = 0; i < boards(); ++i) {
+            Slot& s = *slots_[std::size_t(i)];
+            if (!s.parked.load(std::memory_order_acquire)) continue;
+            if (!flat && s.due.load(std::memory_order_relaxed) > now) continue;
+            s.parked.store(false, std::memory_order_relaxed);
+            pool_->submit(i);
+        }
+    }
+
+    /* f(const View&) on board i's latest snapshot; never waits */
+    template <class F>
+    void read(int i, F&& f) { slots_[std::size_t(i)]->view.read(std::forward<F>(f)); }
+
+    std::uint64_t moves() const
+    {
+        std::uint64_t n = 0;
+        for (const Counter& c : counters_) n += c.moves.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    std::uint64_t rounds() const
+    {
+        std::uint64_t n = 0;
+        for (const Counter& c : counters_) n += c.rounds.load(std::memory_order_relaxed);
+        return n;
+    }
+};
@@ -0,0 +1,243 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Board storage
+ *  – one contiguous row-major array for values and one for liveness
+ *  – sums of *live* values, cut into CHUNK×CHUNK chunks so that a
+ *    clear costs the same on a 1000×1000 board as on the classic one.
+ *    The prefix sum P(r,c) of [0,r)×[0,c) is four lookups:
+ *      grid_   whole chunks above and to the left of (r,c)'s chunk
+ *      left_   the rows of r's chunk row above r, whole chunks left
+ *      up_     the columns of c's chunk column left of c, whole
+ *              chunks above
+ *      local_  the chunk's own summed-area table
+ *    so the sum of any rectangle stays O(1)
+ *  – clearing a rectangle rebuilds the tables of the chunks it killed
+ *    cells in, then left_ over their chunk rows, up_ over their chunk
+ *    columns and grid_: O(CHUNK² + rows + cols + chunk count) per
+ *    chunk touched, never the whole board
+ *  – a board that fits one chunk (every preset) has a chunk of its own
+ *    size: local_ is then exactly the board's summed-area table, sums
+ *    are four lookups into it, and a clear patches only the part of
+ *    it below and to the right of the rectangle
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/* keeps the chunked sum out of Board::sum(), whose one-chunk path sits
+   in the inner loops of the move scans                               */
+#if defined(_MSC_VER)
+#  define FRUITBOX_NOINLINE __declspec(noinline)
+#else
+#  define FRUITBOX_NOINLINE __attribute__((noinline))
+#endif
+
+class Board {
+public:
+    static constexpr int CHUNK = 32;             // power of two
+
+private:
+    static constexpr int SHIFT = 5;              // log2(CHUNK)
+    static_assert(1 << SHIFT == CHUNK, "CHUNK must be 1 << SHIFT");
+
+    int rows_ = 0, cols_ = 0;
+    int ch_ = 0, cw_ = 0;                        // chunk height, width (min(side, CHUNK))
+    int nr_ = 0, nc_ = 0;                        // chunk rows, chunk columns
+    int ls_ = 0;                                 // ints per local table, (ch+1)×(cw+1)
+    bool single_ = true;                         // one chunk: local_ is the whole SAT
+    std::vector<std::uint8_t> value_;            // 1-9 per cell
+    std::vector<std::uint8_t> alive_;            // 1 = still visible
+    std::vector<int>          local_;            // per chunk: sum of its [0,r)×[0,c)
+    std::vector<int>          grid_;             // [R·nc+C]
+    std::vector<int>          left_;             // [r·nc+C]
+    std::vector<int>          up_;               // [c·nr+R]
+    std::vector<int>          dirty_;            // chunk ids, scratch for clear()
+    std::vector<int>          delta_;            // scratch for patch()
+
+    int  idx(int r, int c) const { return r * cols_ + c; }
+    int& S(int r, int c)         { return local_[r * (cols_ + 1) + c]; }
+    int  S(int r, int c) const   { return local_[r * (cols_ + 1) + c]; }
+    int* L(int k)                { return &local_[std::size_t(k) * ls_]; }
+    const int* L(int k) const    { return &local_[std::size_t(k) * ls_]; }
+
+    /* P(r,c) = sum of live values in [0,r)×[0,c); r <= rows, c <= cols */
+    int prefix(int r, int c) const
+    {
+        int R = std::min(r >> SHIFT, nr_ - 1), C = std::min(c >> SHIFT, nc_ - 1);
+        int k = R * nc_ + C;
+        return grid_[k] + left_[r * nc_ + C] + up_[c * nr_ + R]
+             + L(k)[(r - (R << SHIFT)) * (cw_ + 1) + c - (C << SHIFT)];
+    }
+
+    FRUITBOX_NOINLINE int chunkedSum(int r1, int c1, int r2, int c2) const
+    {
+        return prefix(r2 + 1, c2 + 1) - prefix(r1, c2 + 1)
+             - prefix(r2 + 1, c1)     + prefix(r1, c1);
+    }
+
+    void buildChunk(int R, int C)
+    {
+        int* t = L(R * nc_ + C);
+        const int W = cw_ + 1;
+        for (int r = 0; r < ch_; ++r) {
+            int gr = (R << SHIFT) + r, row = 0;
+            for (int c = 0; c < cw_; ++c) {
+                int gc = (C << SHIFT) + c;
+                if (gr < rows_ && gc < cols_ && alive_[idx(gr, gc)]) row += value_[idx(gr, gc)];
+                t[(r + 1) * W + c + 1] = t[r * W + c + 1] + row;
+            }
+        }
+    }
+
+    /* left_ for every r of chunk row R (and r = rows in the last one) */
+    void buildLeft(int R)
+    {
+        int end = R == nr_ - 1 ? rows_ : ((R + 1) << SHIFT) - 1;
+        for (int r = R << SHIFT; r <= end; ++r) {
+            int lr = r - (R << SHIFT), *row = &left_[r * nc_];
+            row[0] = 0;
+            for (int C = 1; C < nc_; ++C)
+                row[C] = row[C - 1] + L(R * nc_ + C - 1)[lr * (cw_ + 1) + cw_];
+        }
+    }
+
+    /* up_ for every c of chunk column C (and c = cols in the last one) */
+    void buildUp(int C)
+    {
+        int end = C == nc_ - 1 ? cols_ : ((C + 1) << SHIFT) - 1;
+        for (int c = C << SHIFT; c <= end; ++c) {
+            int lc = c - (C << SHIFT), *col = &up_[c * nr_];
+            col[0] = 0;
+            for (int R = 1; R < nr_; ++R)
+                col[R] = col[R - 1] + L((R - 1) * nc_ + C)[ch_ * (cw_ + 1) + lc];
+        }
+    }
+
+    void buildGrid()
+    {
+        for (int R = 0; R < nr_; ++R)
+            for (int C = 0; C < nc_; ++C)
+                grid_[R * nc_ + C] = R && C
+                    ? grid_[(R - 1) * nc_ + C] + grid_[R * nc_ + C - 1]
+                      - grid_[(R - 1) * nc_ + C - 1] + L((R - 1) * nc_ + C - 1)[ls_ - 1]
+                    : 0;
+    }
+
+    /* one chunk: subtract the removed values from the part of the table
+       below and to the right of the rectangle. delta_[c+1] = live value
+       removed in cols [c1,c] of the rows processed so far; it stops
+       growing past r2 and past c2                                     */
+    void patch(int r1, int c1, int r2, int c2, std::vector<int>* killed)
+    {
+        std::fill(delta_.begin() + c1, delta_.end(), 0);
+        for (int r = r1; r < rows_; ++r) {
+            if (r <= r2) {
+                int row = 0;
+                for (int c = c1; c <= c2; ++c) {
+                    std::uint8_t& a = alive_[idx(r, c)];
+                    if (a) {
+                        row += value_[idx(r, c)]; a = 0;
+                        if (killed) killed->push_back(idx(r, c));
+                    }
+                    delta_[c + 1] += row;
+                }
+                for (int c = c2 + 1; c < cols_; ++c)
+                    delta_[c + 1] += row;
+            }
+            for (int c = c1; c < cols_; ++c)
+                S(r + 1, c + 1) -= delta_[c + 1];
+        }
+    }
+
+    /* several chunks: rebuild the ones that lost a cell, then the
+       cross-chunk tables over their chunk rows and columns            */
+    void clearChunks(int r1, int c1, int r2, int c2, std::vector<int>* killed)
+    {
+        dirty_.clear();
+        for (int r = r1; r <= r2; ++r)
+            for (int c = c1; c <= c2; ++c) {
+                std::uint8_t& a = alive_[idx(r, c)];
+                if (!a) continue;
+                a = 0;
+                if (killed) killed->push_back(idx(r, c));
+                int k = (r >> SHIFT) * nc_ + (c >> SHIFT);
+                if (std::find(dirty_.begin(), dirty_.end(), k) == dirty_.end())
+                    dirty_.push_back(k);
+            }
+
+        /* a move kills at most target cells, so dirty_ stays short */
+        for (int k : dirty_) buildChunk(k / nc_, k % nc_);
+        for (std::size_t i = 0; i < dirty_.size(); ++i) {
+            int R = dirty_[i] / nc_, C = dirty_[i] % nc_;
+            auto seen = [&](auto same) {
+                return std::any_of(dirty_.begin(), dirty_.begin() + i, same);
+            };
+            if (!seen([&](int k) { return k / nc_ == R; })) buildLeft(R);
+            if (!seen([&](int k) { return k % nc_ == C; })) buildUp(C);
+        }
+        buildGrid();
+    }
+
+public:
+    Board() = default;
+    Board(int rows, int cols) { resize(rows, cols); }
+
+    void resize(int rows, int cols)
+    {
+        rows_ = rows; cols_ = cols;
+        ch_ = std::min(rows, CHUNK);  cw_ = std::min(cols, CHUNK);
+        nr_ = (rows + CHUNK - 1) >> SHIFT;  nc_ = (cols + CHUNK - 1) >> SHIFT;
+        ls_ = (ch_ + 1) * (cw_ + 1);
+        single_ = nr_ == 1 && nc_ == 1;
+        value_.assign(std::size_t(rows) * cols, 0);
+        alive_.assign(std::size_t(rows) * cols, 1);
+        local_.assign(std::size_t(nr_) * nc_ * ls_, 0);
+        grid_.assign(std::size_t(nr_) * nc_, 0);
+        left_.assign(std::size_t(rows + 1) * nc_, 0);
+        up_.assign(std::size_t(cols + 1) * nr_, 0);
+        delta_.assign(single_ ? std::size_t(cols + 1) : 0, 0);
+    }
+
+    int  rows() const                { return rows_; }
+    int  cols() const                { return cols_; }
+    int  value(int r, int c) const   { return value_[idx(r, c)]; }
+    bool alive(int r, int c) const   { return alive_[idx(r, c)] != 0; }
+
+    /* raw fill; call rebuildSums() once all cells are set */
+    void set(int r, int c, int v)    { value_[idx(r, c)] = std::uint8_t(v);
+                                       alive_[idx(r, c)] = 1; }
+
+    void rebuildSums()
+    {
+        for (int R = 0; R < nr_; ++R)
+            for (int C = 0; C < nc_; ++C) buildChunk(R, C);
+        for (int R = 0; R < nr_; ++R) buildLeft(R);
+        for (int C = 0; C < nc_; ++C) buildUp(C);
+        buildGrid();
+    }
+
+    /* sum of live values in the inclusive rectangle [r1,r2]×[c1,c2] */
+    int sum(int r1, int c1, int r2, int c2) const
+    {
+        if (!single_) return chunkedSum(r1, c1, r2, c2);
+        return S(r2 + 1, c2 + 1) - S(r1, c2 + 1)
+             - S(r2 + 1, c1)     + S(r1, c1);
+    }
+
+    int total() const { return single_ ? S(rows_, cols_) : prefix(rows_, cols_); }
+
+    /* the summed-area table of the first chunk, row-major (ch+1)×(cw+1):
+       the whole board's, (rows+1)×(cols+1), when rows and cols are at
+       most CHUNK – for kernels that know the stride at compile time
+       (Kernels.hpp)                                                    */
+    const int* sums() const { return local_.data(); }
+
+    /* kill every cell in [r1,r2]×[c1,c2] and patch the sums; the
+       row-major indexes of cells that were live go to `killed`        */
+    void clear(int r1, int c1, int r2, int c2, std::vector<int>* killed = nullptr)
+    {
+        if (sum(r1, c1, r2, c2) == 0) return;   // nothing live inside
+        if (single_) patch(r1, c1, r2, c2, killed);
+        else         clearChunks(r1, c1, r2, c2, killed);
+    }
+};
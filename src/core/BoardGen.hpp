@@ -0,0 +1,41 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Board generation
+ *  – boards are a pure function of a 64-bit seed: splitmix64 with an
+ *    unbiased draw of lo..hi (1-9 classic; at most 16 values, one
+ *    4-bit draw each), so a seed gives the same board on every
+ *    compiler and standard library (std::uniform_int_distribution
+ *    does not guarantee that)
+ *  – optional quality filter: a board is accepted only if it offers
+ *    at least `minMoves` valid rectangles
+ * ------------------------------------------------------------------ */
+#include <cstdint>
+
+#include "Board.hpp"
+
+struct BoardGen {
+    static std::uint64_t splitmix(std::uint64_t& x)
+    {
+        std::uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    static void fill(Board& b, std::uint64_t seed, int lo = 1, int hi = 9)
+    {
+        std::uint64_t s = seed, bits = 0;
+        const int n = hi - lo + 1;                     // values, 1..16
+        int left = 0;                                  // 4-bit draws in `bits`
+        for (int r = 0; r < b.rows(); ++r)
+            for (int c = 0; c < b.cols(); ++c) {
+                int v;
+                do {                                   // reject n..15
+                    if (!left) { bits = splitmix(s); left = 16; }
+                    v = int(bits & 15); bits >>= 4; --left;
+                } while (v >= n);
+                b.set(r, c, lo + v);
+            }
+        b.rebuildSums();
+    }
+};
@@ -0,0 +1,210 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Pool of vetted board seeds
+ *  A worker thread keeps up to `capacity` seeds whose boards pass the
+ *  quality filter, so restarting a round never waits on rejection
+ *  sampling. take() falls back to vetting inline if the pool ran dry.
+ *  The filter is a minimum move count under the rules being played:
+ *  candidates are dealt and counted at those rules' size, values and
+ *  target, so a vetted seed is vetted for the board the player gets.
+ *  Candidate seeds come from a counter-based stream (splitmix64 of an
+ *  entropy base + n) that is consumed strictly in order: the seeds
+ *  handed out depend only on the entropy and the filter in force at
+ *  each take(), never on thread timing, so a recorded session replays
+ *  the same boards. Changing the filter rewinds the stream to just
+ *  after the last seed handed out.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "Moves.hpp"
+
+/* --------------------------------------------------------------------
+ *  Filter steps for a rule set: move counts one standard deviation
+ *  below the mean, the mean, and one above, over a fixed sample of
+ *  boards – roughly 84 %, 50 % and 16 % of boards pass – so a step
+ *  means the same under every preset.
+ *  Only boards that fit one sum chunk (every preset's own size) get
+ *  steps: sampling a marathon board takes far too long for a menu
+ *  click, and its move count hardly strays from the mean anyway.
+ * ------------------------------------------------------------------ */
+struct FilterSteps {
+    static constexpr int COUNT = 3, SAMPLE = 256;
+    int moves[COUNT] = {};                   // all 0: no filter for these rules
+
+    bool usable() const { return moves[0] > 0; }
+
+    /* 1..COUNT for one of the steps, 0 for off or any other count */
+    int level(int minMoves) const
+    {
+        for (int i = 0; i < COUNT; ++i)
+            if (minMoves > 0 && moves[i] == minMoves) return i + 1;
+        return 0;
+    }
+    int at(int level) const { return level > 0 ? moves[level - 1] : 0; }
+};
+
+inline FilterSteps filterSteps(const Rules& r)
+{
+    FilterSteps f;
+    if (r.rows > Board::CHUNK || r.cols > Board::CHUNK) return f;
+    Board b(r.rows, r.cols);
+    double sum = 0, sq = 0;
+    for (int i = 0; i < FilterSteps::SAMPLE; ++i) {
+        BoardGen::fill(b, 0xF17E5ull + std::uint64_t(i), r.lo, r.hi);
+        double n = countMoves(b, r.target);
+        sum += n; sq += n * n;
+    }
+    double mean = sum / FilterSteps::SAMPLE;
+    double sd   = std::sqrt(std::max(0.0, sq / FilterSteps::SAMPLE - mean * mean));
+    if (mean < 1) return f;                  // nothing to filter on
+    int prev = 0;
+    for (int i = 0; i < FilterSteps::COUNT; ++i)
+        prev = f.moves[i] = std::max(prev + 1, int(std::lround(mean + (i - 1) * sd)));
+    return f;
+}
+
+/* the same filter step under other rules; off where they have none */
+inline int rescaleFilter(const Rules& from, const Rules& to, int minMoves)
+{
+    if (!minMoves || from == to) return minMoves;
+    return filterSteps(to).at(filterSteps(from).level(minMoves));
+}
+
+class BoardPool {
+    struct Vetted { std::uint64_t seed, next; };     // next: stream position after it
+
+    const std::uint64_t        base_;
+    const std::size_t          capacity_;
+    std::atomic<int>           minMoves_;
+    Rules                      rules_;       // boards are vetted under these
+
+    std::deque<Vetted>         ready_;
+    std::uint64_t              next_  = 0;   // where vetting continues
+    std::uint64_t              taken_ = 0;   // position after the last seed handed out
+    std::uint64_t              gen_   = 0;   // bumped when in-flight work goes stale
+    std::mutex                 m_;
+    std::condition_variable    cv_;
+    bool                       stop_ = false;
+    std::thread                worker_;
+
+    /* first candidate at or after position n whose board under `r`
+       offers at least minMoves moves; n ends up just past it          */
+    std::uint64_t vet(std::uint64_t& n, int minMoves, const Rules& r, Board& scratch) const
+    {
+        if (minMoves > 0 && (scratch.rows() != r.rows || scratch.cols() != r.cols))
+            scratch.resize(r.rows, r.cols);
+        for (;;) {
+            std::uint64_t x = base_ + n++;
+            std::uint64_t seed = BoardGen::splitmix(x);
+            if (minMoves <= 0) return seed;
+            BoardGen::fill(scratch, seed, r.lo, r.hi);
+            if (countMoves(scratch, r.target) >= minMoves) return seed;
+        }
+    }
+
+    /* seeds vetted under the old filter are dropped; m_ held */
+    void refilter()
+    {
+        ready_.clear();
+        next_ = taken_;
+        ++gen_;
+    }
+
+    void run()
+    {
+        Board scratch;
+        std::unique_lock<std::mutex> lk(m_);
+        while (!stop_) {
+            if (ready_.size() >= capacity_) { cv_.wait(lk); continue; }
+            std::uint64_t gen = gen_, n = next_;
+            int want = minMoves_;
+            Rules rules = rules_;
+            lk.unlock();
+            std::uint64_t seed = vet(n, want, rules, scratch);
+            lk.lock();
+            if (gen == gen_) { ready_.push_back({ seed, n }); next_ = n; }
+        }
+    }
+
+public:
+    explicit BoardPool(std::uint64_t entropy, int minMoves = 0,
+                       const Rules& rules = Classic::RULES, std::size_t capacity = 16)
+        : base_(entropy), capacity_(capacity), minMoves_(minMoves), rules_(rules)
+    {
+        worker_ = std::thread([this] { run(); });
+    }
+
+    ~BoardPool()
+    {
+        { std::lock_guard<std::mutex> lk(m_); stop_ = true; }
+        cv_.notify_all();
+        worker_.join();
+    }
+
+    BoardPool(const BoardPool&)            = delete;
+    BoardPool& operator=(const BoardPool&) = delete;
+
+    std::uint64_t entropy()  const { return base_; }
+    int           minMoves() const { return minMoves_; }
+
+    /* change the filter; seeds vetted under the old one are dropped */
+    void setMinMoves(int n)
+    {
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            minMoves_ = n;
+            refilter();
+        }
+        cv_.notify_all();
+    }
+
+    /* a seed vetted for a board under `rules`; other rules than the
+       pool's so far refilter first, at the same point of the stream   */
+    std::uint64_t take(const Rules& rules)
+    {
+        std::uint64_t n;
+        int want;
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            if (rules != rules_) {
+                rules_ = rules;
+                refilter();
+            }
+            if (!ready_.empty()) {
+                Vetted v = ready_.front();
+                ready_.pop_front();
+                taken_ = v.next;
+                cv_.notify_all();
+                return v.seed;
+            }
+            /* dry: vet the next seed here; the worker's in-flight one
+               would come from the same position, so it is discarded   */
+            n = next_;
+            want = minMoves_;
+            ++gen_;
+        }
+        Board scratch;
+        std::uint64_t seed = vet(n, want, rules, scratch);
+        {
+            std::lock_guard<std::mutex> lk(m_);
+            ready_.clear();            // the worker restarted from the same spot
+            next_ = taken_ = n;
+            ++gen_;
+        }
+        cv_.notify_all();
+        return seed;
+    }
+
+    std::size_t ready()
+    {
+        std::lock_guard<std::mutex> lk(m_);
+        return ready_.size();
+    }
+};
@@ -0,0 +1,33 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Greedy bot: plays the smallest-area rectangle that sums to the
+ *  round's target.
+ *  Scans every top-left corner and grows the rectangle with SAT
+ *  lookups, stopping a direction as soon as the sum overshoots
+ *  (live values are positive, so sums only grow).
+ * ------------------------------------------------------------------ */
+#include "Round.hpp"
+
+inline bool greedyMove(const Round& round, Rect& out)
+{
+    const Board& b = round.board();
+    const int    T = round.target();
+    int best = 0;
+    for (int r1 = 0; r1 < b.rows(); ++r1)
+        for (int c1 = 0; c1 < b.cols(); ++c1)
+        {
+            if (!b.alive(r1, c1)) continue;          // anchor on a live cell
+            for (int r2 = r1; r2 < b.rows(); ++r2) {
+                if (b.sum(r1, c1, r2, c1) > T) break;
+                for (int c2 = c1; c2 < b.cols(); ++c2) {
+                    int s = b.sum(r1, c1, r2, c2);
+                    if (s > T) break;
+                    if (s < T) continue;
+                    Rect m{ r1, c1, r2, c2 };
+                    if (!best || m.area() < best) { best = m.area(); out = m; }
+                    break;                           // wider is never smaller
+                }
+            }
+        }
+    return best != 0;
+}
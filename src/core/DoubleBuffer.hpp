@@ -0,0 +1,53 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Lock-free double-buffered snapshot: one writer, one reader
+ *  – the writer fills the buffer that is not published, then flips;
+ *    the reader copies or draws from the published one
+ *  – neither side ever waits: the reader marks the buffer it holds,
+ *    and a writer that would overwrite it drops that update instead
+ *    (publish() returns false; try again later)
+ *  – one atomic word: bit 0 the published buffer, bit 1 "reader holds
+ *    a buffer", bit 2 which one
+ *  The writer may change threads between publishes as long as those
+ *  are ordered (e.g. by the hand-over of a job between workers).
+ * ------------------------------------------------------------------ */
+#include <atomic>
+
+template <class T>
+class DoubleBuffer {
+    static constexpr unsigned FRONT = 1, HELD = 2, HELD_IDX = 4;
+
+    T                     buf_[2];
+    std::atomic<unsigned> state_{0};
+
+public:
+    /* writer: fill(T&) the back buffer and publish it; false (nothing
+       written) while the reader still holds that buffer               */
+    template <class F>
+    bool publish(F&& fill)
+    {
+        unsigned s = state_.load(std::memory_order_acquire);
+        unsigned back = (s & FRONT) ^ 1u;
+        if ((s & HELD) && ((s & HELD_IDX) ? 1u : 0u) == back) return false;
+        fill(buf_[back]);
+        s = state_.load(std::memory_order_relaxed);
+        while (!state_.compare_exchange_weak(s, (s & ~FRONT) | back,
+                                             std::memory_order_release,
+                                             std::memory_order_relaxed)) {}
+        return true;
+    }
+
+    /* reader: f(const T&) on the latest published buffer */
+    template <class F>
+    void read(F&& f)
+    {
+        unsigned s = state_.load(std::memory_order_relaxed);
+        unsigned held;
+        do held = s & FRONT;
+        while (!state_.compare_exchange_weak(s, s | HELD | (held ? HELD_IDX : 0u),
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed));
+        f(static_cast<const T&>(buf_[held]));
+        state_.fetch_and(~(HELD | HELD_IDX), std::memory_order_release);
+    }
+};
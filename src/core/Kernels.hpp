@@ -0,0 +1,81 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Move kernels specialised on a rule preset (Rules.hpp)
+ *  – rows, columns and target are constants: a preset's board is one
+ *    sum chunk (Board.hpp), whose summed-area table's stride folds
+ *    into every index, and all scratch lives on the stack
+ *  – forEachMove(): the prefix sums of every row are taken once (one
+ *    pass over two table rows each); a row band then grows by adding
+ *    the next row's prefix sums to it, COLS+1 ints in a loop of fixed
+ *    length that the compiler turns into SIMD adds, and the two-
+ *    pointer sweep runs on that band instead of four lookups per step
+ *  – a band whose live columns all exceed the target holds no move,
+ *    nor does any taller one: counted in the same fixed-length pass,
+ *    it ends the band's growth before any sweep
+ *  – same moves, in the same order, as the generic sweep
+ *  Only move enumeration is specialised: a single rectangle sum is
+ *  four lookups either way, and a folded stride measured no faster.
+ *  withKernel() picks the kernel for a board and target, if any.
+ * ------------------------------------------------------------------ */
+#include <utility>
+
+#include "Board.hpp"
+#include "Round.hpp"
+#include "Rules.hpp"
+
+template <class P>
+struct MoveKernel {
+    static constexpr int R = P::ROWS, C = P::COLS, T = P::TARGET, W = C + 1;
+    static_assert(R <= Board::CHUNK && C <= Board::CHUNK,
+                  "kernels read the board's single summed-area chunk");
+
+    static bool fits(const Board& b, int target)
+    { return target == T && b.rows() == R && b.cols() == C; }
+
+    template <class F>
+    static void forEachMove(const Board& b, F&& emit)
+    {
+        const int* S = b.sums();
+        int row[R][W];                                    // row r, cols [0,c)
+        for (int r = 0; r < R; ++r)
+            for (int c = 0; c < W; ++c) row[r][c] = S[(r + 1) * W + c] - S[r * W + c];
+
+        for (int r1 = 0; r1 < R; ++r1) {
+            if (!row[r1][C]) continue;                    // empty top row
+            int band[W] = {};                             // rows [r1,r2], cols [0,c)
+            for (int r2 = r1; r2 < R; ++r2) {
+                int fits = 0;                             // live columns within T
+                for (int c = 0; c < W; ++c) band[c] += row[r2][c];
+                for (int c = 0; c < C; ++c) {
+                    int col = band[c + 1] - band[c];
+                    fits += col && col <= T;
+                }
+                if (!fits) break;                         // every column overshoots:
+                                                          // no move here or below
+                if (!row[r2][C]) continue;                // empty bottom row
+
+                int c2 = 1;
+                for (int c1 = 0; c1 < C; ++c1) {
+                    int p1 = band[c1];
+                    if (band[c1 + 1] == p1) continue;     // dead left column
+                    if (c2 <= c1) c2 = c1 + 1;
+                    while (band[c2] - p1 < T && c2 < C) ++c2;
+                    if (band[c2] - p1 != T) continue;
+                    if (row[r1][c2] != row[r1][c1] && row[r2][c2] != row[r2][c1])
+                        emit(Rect{ r1, c1, r2, c2 - 1 });
+                }
+            }
+        }
+    }
+};
+
+/* f(MoveKernel<P>{}) for the preset P that fits; false if none does */
+template <class F, class... Ps>
+bool withKernel(const Board& b, int target, PresetList<Ps...>, F&& f)
+{
+    return ((MoveKernel<Ps>::fits(b, target) && (f(MoveKernel<Ps>{}), true)) || ...);
+}
+
+template <class F>
+bool withKernel(const Board& b, int target, F&& f)
+{ return withKernel(b, target, Specialised{}, std::forward<F>(f)); }
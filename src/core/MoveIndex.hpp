@@ -0,0 +1,187 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Index of every valid (tight) move on a board, kept up to date
+ *  while cells are cleared
+ *  – built once per board with forEachMove(), for the round's target
+ *  – a tight move holds at most target live cells, and it stays valid
+ *    exactly as long as none of them is cleared. Each move is filed
+ *    under each of its live cells (intrusive lists, one head per
+ *    cell), so a clear – again at most target cells – kills precisely
+ *    the moves listed under the cleared cells
+ *  – a move that appears must contain a cleared cell (otherwise its
+ *    sum and edges did not change), so the rescan only visits row
+ *    bands and columns around the cleared cells' bounding box, with
+ *    the same overshoot pruning as forEachMove()
+ *  The cost of an update follows the cleared region, not the board.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Moves.hpp"
+
+class MoveIndex {
+    struct Entry { int move; std::uint32_t gen; int next; };
+
+    int                        cols_ = 0;
+    int                        target_ = Round::TARGET;
+    std::vector<Rect>          moves_;           // by move id
+    std::vector<std::uint8_t>  live_;            // 1 = still valid
+    std::vector<std::uint32_t> gen_;             // bumped when an id is reused
+    std::vector<int>           freeMoves_;       // recycled ids
+    int                        count_ = 0;
+
+    std::vector<int>           head_;            // per cell, first entry or -1
+    std::vector<Entry>         entries_;
+    int                        freeEntry_ = -1;
+
+    int newEntry(int move, int next)
+    {
+        if (freeEntry_ < 0) {
+            entries_.push_back({ move, gen_[move], next });
+            return int(entries_.size()) - 1;
+        }
+        int e = freeEntry_;
+        freeEntry_ = entries_[e].next;
+        entries_[e] = { move, gen_[move], next };
+        return e;
+    }
+
+    void add(const Board& b, const Rect& m)
+    {
+        int id;
+        if (freeMoves_.empty()) {
+            id = int(moves_.size());
+            moves_.push_back(m); live_.push_back(1); gen_.push_back(0);
+        } else {
+            id = freeMoves_.back(); freeMoves_.pop_back();
+            moves_[id] = m; live_[id] = 1; ++gen_[id];
+        }
+        ++count_;
+        for (int r = m.r1; r <= m.r2; ++r)
+            for (int c = m.c1; c <= m.c2; ++c)
+                if (b.alive(r, c)) head_[r * cols_ + c] = newEntry(id, head_[r * cols_ + c]);
+    }
+
+    /* the whole list of a cleared cell goes; entries of moves that
+       died through another cell (stale generation) are recycled too   */
+    void killCell(int cell)
+    {
+        for (int e = head_[cell]; e >= 0; ) {
+            int next = entries_[e].next, id = entries_[e].move;
+            if (live_[id] && gen_[id] == entries_[e].gen) {
+                live_[id] = 0; --count_; freeMoves_.push_back(id);
+            }
+            entries_[e].next = freeEntry_;
+            freeEntry_ = e;
+            e = next;
+        }
+        head_[cell] = -1;
+    }
+
+    /* every tight move that contains one of `cells`, whose bounding
+       box is [br1,br2]×[bc1,bc2]                                      */
+    template <class F>
+    void movesThrough(const Board& b, const std::vector<int>& cells,
+                      int br1, int bc1, int br2, int bc2, F&& emit) const
+    {
+        const int T = target_, C = b.cols();
+        auto contains = [&](const Rect& m) {
+            for (int cell : cells) {
+                int r = cell / C, c = cell % C;
+                if (r >= m.r1 && r <= m.r2 && c >= m.c1 && c <= m.c2) return true;
+            }
+            return false;
+        };
+        /* a band [r1,r2] can only hold a move through the box if one
+           of the box's columns stays within target over it            */
+        auto open = [&](int r1, int r2) {
+            for (int c = bc1; c <= bc2; ++c)
+                if (b.sum(r1, c, r2, c) <= T) return true;
+            return false;
+        };
+
+        for (int r1 = br2; r1 >= 0; --r1) {
+            if (!open(r1, std::max(r1, br1))) {
+                if (r1 <= br1) break;                     // taller bands overshoot too
+                continue;
+            }
+            if (!b.sum(r1, 0, r1, C - 1)) continue;      // empty top row
+            for (int r2 = std::max(r1, br1); r2 < b.rows(); ++r2) {
+                if (!open(r1, r2)) break;
+                if (!b.sum(r2, 0, r2, C - 1)) continue;  // empty bottom row
+
+                /* leftmost useful c1: the band from c1 to bc1 within target */
+                int lo = bc1;
+                while (lo > 0 && b.sum(r1, lo - 1, r2, bc1) <= T) --lo;
+
+                auto P = [&](int c) { return c ? b.sum(r1, 0, r2, c - 1) : 0; };
+                int c2 = lo + 1, p2 = P(c2);
+                for (int c1 = lo; c1 <= bc2; ++c1) {
+                    int p1 = P(c1);
+                    if (P(c1 + 1) == p1) continue;        // dead left column
+                    if (c2 <= c1) { c2 = c1 + 1; p2 = P(c2); }
+                    while (p2 - p1 < T && c2 < C) p2 = P(++c2);
+                    if (p2 - p1 != T || c2 - 1 < bc1) continue;
+                    Rect m{ r1, c1, r2, c2 - 1 };
+                    if (b.sum(r1, c1, r1, m.c2) && b.sum(r2, c1, r2, m.c2) && contains(m))
+                        emit(m);
+                }
+            }
+        }
+    }
+
+public:
+    void build(const Board& b, int target = Round::TARGET)
+    {
+        cols_   = b.cols();
+        target_ = target;
+        moves_.clear(); live_.clear(); gen_.clear(); freeMoves_.clear();
+        entries_.clear(); freeEntry_ = -1;
+        head_.assign(std::size_t(b.rows()) * b.cols(), -1);
+        count_ = 0;
+        forEachMove(b, target, [&](const Rect& m) { add(b, m); });
+
+        /* room for the moves a round uncovers, so a clear does not grow
+           the index: greedy play on classic boards peaks at ~1.2x the
+           moves and ~1.8x the entries of the fresh board. A board that
+           leaves less than 2x grows it to 3x, so the next board of about
+           the same size fits too                                       */
+        auto room = [](auto& v, std::size_t n) { if (v.capacity() < 2 * n) v.reserve(3 * n); };
+        room(moves_, moves_.size());  room(live_, moves_.size());
+        room(gen_, moves_.size());    room(freeMoves_, moves_.size());
+        room(entries_, entries_.size());
+    }
+
+    /* `cleared`: row-major indexes of the cells just removed from b */
+    void update(const Board& b, const std::vector<int>& cleared)
+    {
+        if (cleared.empty()) return;
+        int r1 = b.rows(), c1 = cols_, r2 = -1, c2 = -1;
+        for (int cell : cleared) {
+            int r = cell / cols_, c = cell % cols_;
+            r1 = std::min(r1, r); r2 = std::max(r2, r);
+            c1 = std::min(c1, c); c2 = std::max(c2, c);
+            killCell(cell);
+        }
+        movesThrough(b, cleared, r1, c1, r2, c2, [&](const Rect& m) { add(b, m); });
+    }
+
+    int count() const { return count_; }
+
+    /* the smallest valid move, as the greedy bot would pick it */
+    bool hint(Rect& out) const
+    {
+        int best = 0;
+        for (std::size_t i = 0; i < moves_.size(); ++i)
+            if (live_[i] && (!best || moves_[i].area() < best)) { best = moves_[i].area(); out = moves_[i]; }
+        return best != 0;
+    }
+
+    template <class F>
+    void forEach(F&& f) const
+    {
+        for (std::size_t i = 0; i < moves_.size(); ++i)
+            if (live_[i]) f(moves_[i]);
+    }
+};
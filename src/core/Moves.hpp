@@ -0,0 +1,77 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Move enumeration
+ *  A move is a rectangle whose live cells sum to the target. Many
+ *  rectangles clear the same cells (they differ only by dead margins),
+ *  so only *tight* ones are reported: every edge row and column holds
+ *  a live cell, i.e. the rectangle is the bounding box of what it
+ *  clears. Each distinct move is therefore produced exactly once.
+ *  Boards of a preset's size played to its target go through that
+ *  preset's kernel (Kernels.hpp); everything else runs the generic
+ *  sweep below.
+ * ------------------------------------------------------------------ */
+#include <vector>
+
+#include "Round.hpp"
+#include "Kernels.hpp"
+
+inline bool tight(const Board& b, const Rect& s)
+{
+    return b.sum(s.r1, s.c1, s.r1, s.c2) && b.sum(s.r2, s.c1, s.r2, s.c2)
+        && b.sum(s.r1, s.c1, s.r2, s.c1) && b.sum(s.r1, s.c2, s.r2, s.c2);
+}
+
+/* calls emit(Rect) for every tight rectangle summing to `target`.
+   For each row band [r1,r2] the column sums are non-negative, so a
+   two-pointer sweep finds, for every left column holding a live cell,
+   the first right column where the sum reaches the target – the only
+   tight candidate. That is O(rows² · cols) SAT lookups for the whole
+   board. Any size and target; forEachMove() prefers a kernel.       */
+template <class F>
+void forEachMoveGeneric(const Board& b, int target, F&& emit)
+{
+    const int T = target, C = b.cols();
+    for (int r1 = 0; r1 < b.rows(); ++r1) {
+        if (!b.sum(r1, 0, r1, C - 1)) continue;          // empty top row
+        for (int r2 = r1; r2 < b.rows(); ++r2) {
+            if (!b.sum(r2, 0, r2, C - 1)) continue;      // empty bottom row
+
+            /* P(c) = band sum of columns [0,c) */
+            auto P = [&](int c) { return c ? b.sum(r1, 0, r2, c - 1) : 0; };
+            int  minCol = T + 1;
+            int  c2 = 1, p2 = P(1);
+            for (int c1 = 0; c1 < C; ++c1) {
+                int p1 = P(c1), col = P(c1 + 1) - p1;
+                if (col && col < minCol) minCol = col;
+                if (!col) continue;                       // dead left column
+                if (c2 <= c1) { c2 = c1 + 1; p2 = P(c2); }
+                while (p2 - p1 < T && c2 < C) p2 = P(++c2);
+                if (p2 - p1 != T) continue;
+                Rect m{ r1, c1, r2, c2 - 1 };
+                if (b.sum(r1, c1, r1, m.c2) && b.sum(r2, c1, r2, m.c2))
+                    emit(m);
+            }
+            if (minCol > T) break;                        // every column overshoots
+        }
+    }
+}
+
+template <class F>
+void forEachMove(const Board& b, int target, F&& emit)
+{
+    if (!withKernel(b, target, [&](auto k) { decltype(k)::forEachMove(b, emit); }))
+        forEachMoveGeneric(b, target, emit);
+}
+
+inline void validMoves(const Board& b, std::vector<Rect>& out, int target = Round::TARGET)
+{
+    out.clear();
+    forEachMove(b, target, [&](const Rect& m) { out.push_back(m); });
+}
+
+inline int countMoves(const Board& b, int target = Round::TARGET)
+{
+    int n = 0;
+    forEachMove(b, target, [&](const Rect&) { ++n; });
+    return n;
+}
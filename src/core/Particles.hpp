@@ -0,0 +1,122 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Particle pool for clearing effects, in world units (cells)
+ *  – structure of arrays, CAPACITY slots allocated once: live
+ *    particles are packed in [0, size()), a dead one is replaced by
+ *    the last, so nothing is allocated or freed per particle
+ *  – update() is branch-free passes over the arrays (the compiler
+ *    vectorises them), then a sweep that swap-removes the expired
+ *  – age is normalised (0 → 1 over the particle's lifetime), so size
+ *    and fade need no per-particle division
+ *  – burst(): the cleared apple drops and fades, sparks fly off it
+ *  – quads() writes four corners per particle into any vertex type
+ *    with position.{x,y} and color.{r,g,b,a} (sf::Vertex), one batch
+ *  When the pool is full new particles are dropped, never old ones.
+ * ------------------------------------------------------------------ */
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+class Particles {
+public:
+    static constexpr std::size_t CAPACITY = std::size_t(1) << 17;   // 131072
+    static constexpr float       GRAVITY  = 40.f;                   // cells/s²
+    static constexpr int         SPARKS   = 6;                      // per cleared cell
+
+private:
+    std::vector<float>        x_, y_, vx_, vy_;
+    std::vector<float>        age_, rate_;          // age 0..1, 1/lifetime
+    std::vector<float>        size_, shrink_;       // half-side at birth, fraction lost by death
+    std::vector<std::uint8_t> r_, g_, b_;
+    std::size_t               n_   = 0;
+    std::uint32_t             rng_ = 0x9e3779b9u;
+
+    float rand01()                                 // xorshift32, [0,1)
+    {
+        rng_ ^= rng_ << 13; rng_ ^= rng_ >> 17; rng_ ^= rng_ << 5;
+        return float(rng_ >> 8) * (1.f / 16777216.f);
+    }
+
+    void swapIn(std::size_t i, std::size_t j)      // slot i := slot j
+    {
+        x_[i] = x_[j];   y_[i] = y_[j];   vx_[i] = vx_[j]; vy_[i] = vy_[j];
+        age_[i] = age_[j]; rate_[i] = rate_[j];
+        size_[i] = size_[j]; shrink_[i] = shrink_[j];
+        r_[i] = r_[j];   g_[i] = g_[j];   b_[i] = b_[j];
+    }
+
+public:
+    Particles()
+    {
+        for (auto* v : { &x_, &y_, &vx_, &vy_, &age_, &rate_, &size_, &shrink_ })
+            v->resize(CAPACITY);
+        for (auto* v : { &r_, &g_, &b_ }) v->resize(CAPACITY);
+    }
+
+    std::size_t size() const { return n_; }
+    bool        empty() const { return n_ == 0; }
+    void        clear() { n_ = 0; }
+
+    /* one particle; false if the pool is full */
+    bool add(float x, float y, float vx, float vy, float life, float half,
+             float shrink, std::uint8_t r, std::uint8_t g, std::uint8_t b)
+    {
+        if (n_ == CAPACITY) return false;
+        std::size_t i = n_++;
+        x_[i] = x; y_[i] = y; vx_[i] = vx; vy_[i] = vy;
+        age_[i] = 0.f; rate_[i] = 1.f / life;
+        size_[i] = half; shrink_[i] = shrink;
+        r_[i] = r; g_[i] = g; b_[i] = b;
+        return true;
+    }
+
+    /* effects for the cell at (row, col), centre of the cell */
+    void burst(int row, int col)
+    {
+        float cx = col + 0.5f, cy = row + 0.5f;
+        add(cx, cy, (rand01() - 0.5f) * 3.f, -4.f - 3.f * rand01(),      // apple: hop, drop
+            0.7f, 0.45f, 0.6f, 200, 80, 80);                            // live tile colour
+        for (int k = 0; k < SPARKS; ++k) {
+            float a = rand01() * 6.2831853f, v = 4.f + 6.f * rand01();
+            add(cx, cy, std::cos(a) * v, std::sin(a) * v - 4.f, 0.35f + 0.3f * rand01(),
+                0.08f + 0.06f * rand01(), 1.f, 255, std::uint8_t(170 + 80 * rand01()), 60);
+        }
+    }
+
+    void update(float dt)
+    {
+        const std::size_t n = n_;
+        float* x = x_.data(); float* y = y_.data();
+        float* vx = vx_.data(); float* vy = vy_.data();
+        float* age = age_.data(); const float* rate = rate_.data();
+        const float g = GRAVITY * dt;
+        /* two arrays per loop: few enough for the compiler's aliasing
+           checks, so every loop is vectorised                          */
+        for (std::size_t i = 0; i < n; ++i) { vy[i] += g; y[i] += vy[i] * dt; }
+        for (std::size_t i = 0; i < n; ++i) x[i]   += vx[i]   * dt;
+        for (std::size_t i = 0; i < n; ++i) age[i] += rate[i] * dt;
+
+        for (std::size_t i = 0; i < n_; )
+            if (age_[i] >= 1.f) swapIn(i, --n_);
+            else ++i;
+    }
+
+    /* out must hold 4 · size() vertices; texture coordinates are left
+       as they are                                                      */
+    template <class Vertex>
+    void quads(Vertex* out) const
+    {
+        for (std::size_t i = 0; i < n_; ++i, out += 4) {
+            /* everything read before anything is written: the stores
+               could alias the arrays, and reloads would cost more     */
+            float h = size_[i] * (1.f - shrink_[i] * age_[i]);
+            float l = x_[i] - h, r = x_[i] + h, t = y_[i] - h, b = y_[i] + h;
+            const decltype(out->color) col{ r_[i], g_[i], b_[i],
+                                            std::uint8_t(255.f * (1.f - age_[i])) };
+            out[0].position.x = l; out[0].position.y = t; out[0].color = col;
+            out[1].position.x = r; out[1].position.y = t; out[1].color = col;
+            out[2].position.x = r; out[2].position.y = b; out[2].color = col;
+            out[3].position.x = l; out[3].position.y = b; out[3].color = col;
+        }
+    }
+};
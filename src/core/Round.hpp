@@ -0,0 +1,147 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  One round of Fruit Box, without any SFML
+ *  – board generation from a 64-bit seed (see BoardGen.hpp); the
+ *    classic board is ROWS×COLS, any size up to MAX_SIDE works
+ *  – the selection rule: a rectangle whose live cells sum to the
+ *    target (TARGET = 10 in the classic rules, see Rules.hpp) is
+ *    cleared and scores one point
+ *  – the 120 s countdown, kept in whole simulation ticks: the round
+ *    lasts exactly LENGTH_TICKS however the frames fall, and the end
+ *    is reached by stepping, never by a float dt jumping past it
+ *  – finishing early (no move left on the board) stops the clock and
+ *    pays one bonus point per BONUS_SECS whole seconds still left
+ *  Shared by GameScene and the headless tools.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "Board.hpp"
+#include "BoardGen.hpp"
+#include "Rules.hpp"
+
+/* inclusive cell rectangle, always normalised (r1<=r2, c1<=c2) */
+struct Rect {
+    int r1 = 0, c1 = 0, r2 = 0, c2 = 0;
+
+    static Rect span(int ra, int ca, int rb, int cb)
+    { return { std::min(ra, rb), std::min(ca, cb),
+               std::max(ra, rb), std::max(ca, cb) }; }
+
+    int area() const { return (r2 - r1 + 1) * (c2 - c1 + 1); }
+};
+
+class Round {
+public:
+    static constexpr int   ROWS   = Classic::ROWS, COLS = Classic::COLS;   // the classic board
+    static constexpr int   MAX_SIDE = 1000;
+    static constexpr int   TARGET = Classic::TARGET;   // classic rectangle sum
+    static constexpr int   TICK_HZ      = 250;    // fixed simulation rate
+    static constexpr int   TICK_US      = 1000000 / TICK_HZ;
+    static constexpr int   LENGTH_TICKS = 120 * TICK_HZ;
+    static constexpr float LENGTH = float(LENGTH_TICKS) / TICK_HZ;   // seconds
+    static constexpr int   BONUS_SECS   = 5;
+
+private:
+    Board          board_{ROWS, COLS};
+    Rules          rules_;                        // size always as board_'s
+    std::uint64_t  seed_     = 0;
+    int            score_    = 0;
+    int            moves_    = 0;                 // successful selections
+    int            bonus_    = 0;                 // for finishing early
+    bool           finished_ = false;
+    int            ticks_    = 0;                 // simulation ticks elapsed
+    std::int64_t   carry_    = 0;                 // µs not yet a whole tick
+
+public:
+    explicit Round(std::uint64_t seed = 0) { reset(seed); }
+    Round(std::uint64_t seed, int rows, int cols) { reset(seed, rows, cols); }
+    Round(std::uint64_t seed, const Rules& r)     { reset(seed, r); }
+
+    /* new board of another size, current rules */
+    void reset(std::uint64_t seed, int rows, int cols)
+    { reset(seed, rules_.sized(rows, cols)); }
+
+    /* new board under other rules */
+    void reset(std::uint64_t seed, const Rules& r)
+    {
+        rules_      = r;
+        rules_.rows = std::clamp(r.rows, 1, MAX_SIDE);
+        rules_.cols = std::clamp(r.cols, 1, MAX_SIDE);
+        if (rules_.rows != board_.rows() || rules_.cols != board_.cols())
+            board_.resize(rules_.rows, rules_.cols);
+        reset(seed);
+    }
+
+    /* new board of the current size */
+    void reset(std::uint64_t seed)
+    {
+        seed_ = seed;
+        BoardGen::fill(board_, seed, rules_.lo, rules_.hi);
+        score_    = 0;
+        moves_    = 0;
+        bonus_    = 0;
+        finished_ = false;
+        ticks_    = 0;
+        carry_    = 0;
+    }
+
+    int  sum(const Rect& s) const { return board_.sum(s.r1, s.c1, s.r2, s.c2); }
+
+    /* clear the rectangle if it sums to the target; true on success.
+       `cleared` receives the row-major indexes of the cells removed
+       (at most target() of them, live values being at least 1)      */
+    bool apply(const Rect& s, std::vector<int>* cleared = nullptr)
+    {
+        if (cleared) cleared->clear();
+        if (over() || sum(s) != rules_.target) return false;
+        board_.clear(s.r1, s.c1, s.r2, s.c2, cleared);
+        ++score_;
+        ++moves_;
+        return true;
+    }
+
+    /* one fixed simulation step */
+    void tick()         { if (!over()) ++ticks_; }
+    bool over() const   { return finished_ || ticks_ >= LENGTH_TICKS; }
+
+    /* end now, e.g. because no move is left; returns the bonus paid */
+    int finish()
+    {
+        if (over()) return 0;
+        bonus_    = ticksLeft() / (BONUS_SECS * TICK_HZ);
+        score_   += bonus_;
+        finished_ = true;
+        carry_    = 0;
+        return bonus_;
+    }
+
+    /* feed elapsed wall time; runs every whole tick it covers, keeping
+       the remainder for the next call. Returns the ticks run.          */
+    int advance(std::int64_t micros)
+    {
+        carry_ += micros;
+        std::int64_t n = over() ? 0 : std::min<std::int64_t>(carry_ / TICK_US, ticksLeft());
+        ticks_ += int(n);                 // the timer is all a tick does, so
+        carry_ -= n * TICK_US;            // whole ticks are taken at once
+        if (over()) carry_ = 0;
+        return int(n);
+    }
+
+    const Board&  board()    const { return board_; }
+    int           rows()     const { return board_.rows(); }
+    int           cols()     const { return board_.cols(); }
+    const Rules&  rules()    const { return rules_; }
+    int           target()   const { return rules_.target; }
+    bool          classic()  const { return rules_ == Classic::RULES; }
+    std::uint64_t seed()     const { return seed_; }
+    int           score()    const { return score_; }
+    int           moves()    const { return moves_; }
+    int           bonus()    const { return bonus_; }
+    bool          finished() const { return finished_; }         // ended early
+    int           ticks()    const { return ticks_; }
+    int           ticksLeft() const { return LENGTH_TICKS - ticks_; }
+    int           elapsedMs() const { return int(std::int64_t(ticks_) * 1000 / TICK_HZ); }
+    float         timeLeft() const { return float(ticksLeft()) / TICK_HZ; }
+};
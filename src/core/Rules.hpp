@@ -0,0 +1,61 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Rule sets: board size, the sum a move must reach, and the range of
+ *  values dealt
+ *  – Rules is the runtime form; any size up to Round::MAX_SIDE, any
+ *    target, values lo..hi with 1 <= lo <= hi <= lo + 15 (positive
+ *    values keep every "sums only grow" pruning valid; sixteen values
+ *    at most keep BoardGen's 4-bit draw)
+ *  – Preset<> is the same at compile time; each preset in PRESETS
+ *    gets move kernels specialised on it (Kernels.hpp), every other
+ *    rule set runs the generic code
+ *  The classic game is Classic; only it goes on the leaderboard.
+ * ------------------------------------------------------------------ */
+
+struct Rules {
+    int rows = 10, cols = 17;
+    int target = 10;                 // a move's live cells sum to this
+    int lo = 1, hi = 9;              // values dealt, both inclusive
+
+    constexpr bool operator==(const Rules& o) const
+    {
+        return rows == o.rows && cols == o.cols && target == o.target &&
+               lo == o.lo && hi == o.hi;
+    }
+    constexpr bool operator!=(const Rules& o) const { return !(*this == o); }
+
+    /* same rules on a board of another size */
+    constexpr Rules sized(int r, int c) const { return { r, c, target, lo, hi }; }
+};
+
+template <int Rows, int Cols, int Target, int Lo = 1, int Hi = 9>
+struct Preset {
+    static_assert(Lo >= 1 && Lo <= Hi && Hi - Lo < 16, "values must fit BoardGen's draw");
+    static constexpr int   ROWS = Rows, COLS = Cols, TARGET = Target, LO = Lo, HI = Hi;
+    static constexpr Rules RULES{ Rows, Cols, Target, Lo, Hi };
+};
+
+using Classic  = Preset<10, 17, 10>;          // the original game
+using Fives    = Preset<10, 17,  5, 1, 4>;    // small values, small moves
+using Twenties = Preset<12, 20, 20>;          // bigger board, longer moves
+
+/* presets that get specialised kernels; keep in step with PRESETS */
+template <class... Ps> struct PresetList {};
+using Specialised = PresetList<Classic, Fives, Twenties>;
+
+struct NamedRules { const char* name; Rules rules; };
+
+inline constexpr NamedRules PRESETS[] = {
+    { "Classic",  Classic::RULES  },
+    { "Fives",    Fives::RULES    },
+    { "Twenties", Twenties::RULES },
+};
+inline constexpr int PRESET_COUNT = int(sizeof(PRESETS) / sizeof(PRESETS[0]));
+
+/* the preset with the same target and values (any size), or -1 */
+inline int presetOf(const Rules& r)
+{
+    for (int i = 0; i < PRESET_COUNT; ++i)
+        if (PRESETS[i].rules.sized(r.rows, r.cols) == r) return i;
+    return -1;
+}
@@ -0,0 +1,189 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Beam-search solver
+ *  Every round scores one point per cleared rectangle, so the best
+ *  score of a board is the longest sequence of valid moves.
+ *
+ *  Each layer of the beam is expanded in two parallel passes:
+ *   1. score every (node, move) pair without building the child – the
+ *      key is how many of the node's other moves survive the move
+ *      (a move survives if it shares no live cell with it), ties going
+ *      to the move that clears fewer cells
+ *   2. keep the best `width` distinct children (Zobrist hash of the
+ *      live cells) and only then materialise their boards and moves
+ *  so building boards and enumerating moves happens `width` times per
+ *  layer instead of once per candidate.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "Moves.hpp"
+
+class Solver {
+public:
+    struct Options {
+        int      width   = 1024;             // nodes kept per layer
+        unsigned threads = 0;                // 0 = all cores
+    };
+
+    struct Result {
+        int               score   = 0;
+        std::vector<Rect> moves;             // in play order
+        long long         nodes   = 0;       // candidates evaluated
+        double            seconds = 0;
+    };
+
+private:
+    struct Node {
+        Board             board;
+        std::vector<Rect> moves;             // valid moves from here
+        std::uint64_t     hash = 0;
+        int               trail = -1;        // index into trail_ layer
+    };
+
+    struct Cand {
+        int           node, move;
+        int           key;
+        std::uint64_t hash;
+    };
+
+    struct Step { int parent; Rect move; };
+
+    /* a move clears at most TARGET live cells, so weighting survivors by
+       more than that ranks by survivors first, fewer cleared cells second */
+    static constexpr int KW = Round::TARGET + 1;
+
+    std::vector<std::uint64_t>     zobrist_;
+    std::vector<std::vector<Step>> trail_;   // per depth, for backtracking
+
+    /* run fn(begin, end) over [0,n) split across `threads` workers */
+    template <class F>
+    static void parallelFor(std::size_t n, unsigned threads, F&& fn)
+    {
+        if (threads <= 1 || n < 2) { fn(std::size_t(0), n); return; }
+        threads = unsigned(std::min<std::size_t>(threads, n));
+        std::vector<std::thread> pool;
+        std::size_t chunk = (n + threads - 1) / threads;
+        for (unsigned t = 0; t < threads; ++t) {
+            std::size_t b = t * chunk, e = std::min(n, b + chunk);
+            if (b < e) pool.emplace_back([&fn, b, e] { fn(b, e); });
+        }
+        for (auto& th : pool) th.join();
+    }
+
+    /* Zobrist hash of the live cells m clears; `cells` gets their count */
+    std::uint64_t clearedHash(const Board& b, const Rect& m, int& cells) const
+    {
+        std::uint64_t h = 0;
+        cells = 0;
+        for (int r = m.r1; r <= m.r2; ++r)
+            for (int c = m.c1; c <= m.c2; ++c)
+                if (b.alive(r, c)) { h ^= zobrist_[r * b.cols() + c]; ++cells; }
+        return h;
+    }
+
+    static int survivors(const Node& n, const Rect& m)
+    {
+        int k = 0;
+        for (const Rect& o : n.moves) {
+            int r1 = std::max(o.r1, m.r1), r2 = std::min(o.r2, m.r2);
+            int c1 = std::max(o.c1, m.c1), c2 = std::min(o.c2, m.c2);
+            if (r1 > r2 || c1 > c2 || !n.board.sum(r1, c1, r2, c2)) ++k;
+        }
+        return k;
+    }
+
+public:
+    Result solve(const Board& start) { return solve(start, Options()); }
+
+    Result solve(const Board& start, Options opt)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        unsigned threads = opt.threads ? opt.threads
+                                       : std::max(1u, std::thread::hardware_concurrency());
+
+        std::uint64_t seed = 0x5EEDull;
+        zobrist_.resize(std::size_t(start.rows()) * start.cols());
+        for (auto& z : zobrist_) z = BoardGen::splitmix(seed);
+        trail_.clear();
+
+        std::vector<Node> beam(1);
+        beam[0].board = start;
+        validMoves(start, beam[0].moves);
+
+        std::atomic<long long> nodes{0};
+        std::vector<Cand> cands;
+        std::vector<Node> next;
+        std::unordered_set<std::uint64_t> seen;
+
+        while (true) {
+            /* ---- pass 1: score every candidate ---- */
+            std::vector<std::size_t> firstMove(beam.size() + 1, 0);
+            for (std::size_t i = 0; i < beam.size(); ++i)
+                firstMove[i + 1] = firstMove[i] + beam[i].moves.size();
+            std::size_t total = firstMove.back();
+            if (total == 0) break;
+
+            cands.resize(total);
+            parallelFor(beam.size(), threads, [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    const Node& n = beam[i];
+                    for (std::size_t j = 0; j < n.moves.size(); ++j) {
+                        const Rect& m = n.moves[j];
+                        int cells;
+                        std::uint64_t h = n.hash ^ clearedHash(n.board, m, cells);
+                        cands[firstMove[i] + j] = { int(i), int(j),
+                                                    survivors(n, m) * KW - cells, h };
+                    }
+                }
+                nodes += (long long)(firstMove[e] - firstMove[b]);
+            });
+
+            /* ---- pass 2: keep the best distinct children ---- */
+            std::stable_sort(cands.begin(), cands.end(),
+                             [](const Cand& x, const Cand& y) { return x.key > y.key; });
+            seen.clear();
+            std::vector<Cand> keep;
+            for (const Cand& c : cands) {
+                if (int(keep.size()) >= opt.width) break;
+                if (seen.insert(c.hash).second) keep.push_back(c);
+            }
+
+            trail_.emplace_back(keep.size());
+            next.resize(keep.size());
+            parallelFor(keep.size(), threads, [&](std::size_t b, std::size_t e) {
+                for (std::size_t i = b; i < e; ++i) {
+                    const Cand& c  = keep[i];
+                    const Node& p  = beam[c.node];
+                    const Rect& m  = p.moves[c.move];
+                    Node&       ch = next[i];
+                    ch.board = p.board;
+                    ch.board.clear(m.r1, m.c1, m.r2, m.c2);
+                    validMoves(ch.board, ch.moves);
+                    ch.hash  = c.hash;
+                    ch.trail = int(i);
+                    trail_.back()[i] = { p.trail, m };
+                }
+            });
+            beam.swap(next);
+        }
+
+        /* ---- backtrack from any node of the deepest layer ---- */
+        Result res;
+        res.score = int(trail_.size());
+        res.moves.resize(trail_.size());
+        for (int d = int(trail_.size()) - 1, i = 0; d >= 0; --d) {
+            res.moves[d] = trail_[d][i].move;
+            i = trail_[d][i].parent;
+        }
+        res.nodes   = nodes;
+        res.seconds = std::chrono::duration<double>(
+                          std::chrono::steady_clock::now() - t0).count();
+        return res;
+    }
+};
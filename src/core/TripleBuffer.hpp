@@ -0,0 +1,40 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Lock-free triple buffer: one writer, one reader, latest state wins
+ *  – three slots: the writer's back buffer, the reader's front buffer
+ *    and one in the middle; publish() swaps back and middle, acquire()
+ *    swaps middle and front when the middle holds something newer
+ *  – neither side ever waits and no update is refused: the writer
+ *    always has a free slot (unlike DoubleBuffer, whose writer may
+ *    find its buffer held), the reader always gets the newest one
+ *  – one atomic word: bits 0-1 the middle slot, bit 2 "not read yet"
+ *  A slot comes back to the writer as it was two publishes ago, so
+ *  fill it completely or keep a version per slot.
+ * ------------------------------------------------------------------ */
+#include <atomic>
+
+template <class T>
+class TripleBuffer {
+    static constexpr unsigned IDX = 3, FRESH = 4;
+
+    T                     buf_[3];
+    std::atomic<unsigned> middle_{1};
+    unsigned              back_  = 0;              // writer's
+    unsigned              front_ = 2;              // reader's
+
+public:
+    /* writer: the slot to fill, then publish() it */
+    T&   back() { return buf_[back_]; }
+    void publish()
+    { back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & IDX; }
+
+    /* reader: take the newest published slot, if there is one; false =
+       front() is unchanged                                             */
+    bool acquire()
+    {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_ = middle_.exchange(front_, std::memory_order_acq_rel) & IDX;
+        return true;
+    }
+    const T& front() const { return buf_[front_]; }
+};
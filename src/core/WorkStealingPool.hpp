@@ -0,0 +1,125 @@
+#pragma once
+/* --------------------------------------------------------------------
+ *  Work-stealing thread pool for small recurring jobs
+ *  – a job is an int id; run(job, worker) does one slice of it and
+ *    returns true to run again, false to drop it (submit() brings it
+ *    back later)
+ *  – one deque per worker, each behind its own mutex: the owner takes
+ *    from the front and a job that runs again goes to the back of the
+ *    deque of the worker that ran it, so each worker round-robins over
+ *    its own jobs and steady work stays put
+ *  – an idle worker steals from the back of another's deque: the job
+ *    its owner would reach last
+ *  – workers with nothing to run or steal sleep until submit()
+ *  Mutexes are held only to push or pop an int, never while a job runs.
+ * ------------------------------------------------------------------ */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkStealingPool {
+public:
+    using Run = std::function<bool(int job, int worker)>;
+
+private:
+    struct alignas(64) Worker {
+        std::mutex      m;
+        std::deque<int> jobs;
+        std::thread     thread;
+    };
+
+    Run                                  run_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<int>                     queued_{0};     // jobs in all deques
+    std::atomic<unsigned>                next_{0};       // round-robin for submit()
+    std::atomic<bool>                    stop_{false};
+    std::mutex                           idleM_;
+    std::condition_variable              idleCv_;
+    int                                  sleeping_ = 0;  // guarded by idleM_
+
+    bool pop(Worker& w, int& job, bool front)
+    {
+        std::lock_guard<std::mutex> lk(w.m);
+        if (w.jobs.empty()) return false;
+        if (front) { job = w.jobs.front(); w.jobs.pop_front(); }
+        else       { job = w.jobs.back();  w.jobs.pop_back();  }
+        return true;
+    }
+
+    void push(Worker& w, int job)
+    {
+        { std::lock_guard<std::mutex> lk(w.m); w.jobs.push_back(job); }
+        queued_.fetch_add(1, std::memory_order_release);
+    }
+
+    /* own deque first, then every other one, starting at a rotating victim */
+    bool find(int self, int& job, std::uint32_t& rng)
+    {
+        if (pop(*workers_[std::size_t(self)], job, true)) return true;
+        int n = int(workers_.size());
+        rng = rng * 1664525u + 1013904223u;
+        int v = int((rng >> 16) % std::uint32_t(n));
+        for (int i = 0; i < n; ++i, v = (v + 1) % n)
+            if (v != self && pop(*workers_[std::size_t(v)], job, false)) return true;
+        return false;
+    }
+
+    void loop(int self)
+    {
+        std::uint32_t rng = std::uint32_t(self) * 2654435761u + 1;
+        while (!stop_.load(std::memory_order_acquire)) {
+            int job;
+            if (find(self, job, rng)) {
+                queued_.fetch_sub(1, std::memory_order_relaxed);
+                if (run_(job, self)) push(*workers_[std::size_t(self)], job);
+                continue;
+            }
+            std::unique_lock<std::mutex> lk(idleM_);
+            ++sleeping_;
+            idleCv_.wait(lk, [&] {
+                return stop_.load(std::memory_order_acquire) ||
+                       queued_.load(std::memory_order_acquire) > 0;
+            });
+            --sleeping_;
+        }
+    }
+
+public:
+    /* threads = 0: one per hardware thread, less the caller's */
+    explicit WorkStealingPool(Run run, int threads = 0) : run_(std::move(run))
+    {
+        if (threads <= 0)
+            threads = std::max(1, int(std::thread::hardware_concurrency()) - 1);
+        for (int i = 0; i < threads; ++i) workers_.push_back(std::make_unique<Worker>());
+        for (int i = 0; i < threads; ++i)
+            workers_[std::size_t(i)]->thread = std::thread([this, i] { loop(i); });
+    }
+
+    ~WorkStealingPool()
+    {
+        { std::lock_guard<std::mutex> lk(idleM_); stop_ = true; }
+        idleCv_.notify_all();
+        for (auto& w : workers_) w->thread.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&)            = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int size() const { return int(workers_.size()); }
+
+    /* from any thread; a job must not be queued twice at once */
+    void submit(int job)
+    {
+        unsigned i = next_.fetch_add(1, std::memory_order_relaxed) % unsigned(workers_.size());
+        push(*workers_[i], job);
+        std::lock_guard<std::mutex> lk(idleM_);
+        if (sleeping_) idleCv_.notify_one();
+    }
+};
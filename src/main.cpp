@@ -1,65 +1,414 @@
 #include <SFML/Graphics.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <future>
 #include <iostream>
 #include <memory>
+#include <random>
+#include <string>
 #include "Scene.hpp"
 #include "MenuScene.hpp"
 #include "ConfigScene.hpp"
 #include "GameScene.hpp"
+#include "ArenaScene.hpp"
 #include "InputBindings.hpp"
 #include "Settings.hpp"
+#include "core/BoardPool.hpp"
+#include "FrameProfiler.hpp"
+#include "ProfilerOverlay.hpp"
+#include "InputLog.hpp"
+#include "FramePacer.hpp"
+#include "RenderThread.hpp"
+#include "Resources.hpp"
+#include "StartupProfile.hpp"
+#ifdef FRUITBOX_TRACK_ALLOCS
+#include "AllocHooks.hpp"            // counts operator new per frame phase
+#endif
 
-/* simple font loader ---------------------------------------------------- */
+/* the font is compiled in (see Resources.hpp) ------------------------ */
 static sf::Font loadFont() {
     sf::Font f;
-    const char* paths[] = {
-        "resources/arial.ttf",
-        "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf",
-        "/mnt/c/Windows/Fonts/arial.ttf"
-    };
-    for (auto p : paths) if (f.loadFromFile(p)) return f;
-    throw std::runtime_error("Could not load any TTF font.");
+    Resource r = resource("arial.ttf");
+    if (r.data && f.loadFromMemory(r.data, r.size)) return f;
+    throw std::runtime_error("Could not load the embedded font.");
 }
 
-/* ---------------------------------------------------------------------- */
-int main() {
-    sf::RenderWindow app(sf::VideoMode(1024, 768),
-                         "Fruit Box Local", sf::Style::Default);
-    app.setVerticalSyncEnabled(true);
+/* SFML 2 has no waitEvent with a timeout: poll, napping in between ----- */
+static bool waitEventFor(sf::Window& w, sf::Event& e, float seconds) {
+    sf::Clock c;
+    while (!w.pollEvent(e)) {
+        if (c.getElapsedTime().asSeconds() >= seconds) return false;
+        sf::sleep(sf::milliseconds(4));
+    }
+    return true;
+}
+
+/* one place that knows how to build each scene ------------------------ */
+static std::unique_ptr<Scene> makeScene(SceneID id, sf::Font& font, InputBindings& binds,
+                                        Settings& set, BoardPool& pool, sf::Vector2u size)
+{
+    switch (id) {
+        case SceneID::Menu:   return std::make_unique<MenuScene>(font, set);
+        case SceneID::Config: return std::make_unique<ConfigScene>(font, binds, set, pool);
+        case SceneID::Game:   return std::make_unique<GameScene>(font, binds, set, pool, size);
+        case SceneID::Arena:  return std::make_unique<ArenaScene>(font, size, pool.entropy());
+        default:              return nullptr;
+    }
+}
+
+/* rounds finished during a replay; compare runs of the same log ------- */
+static void printRounds(const ScoreStore& h)
+{
+    for (std::size_t i = 0; i < h.size(); ++i) {
+        RoundRecord r = h.at(i);
+        std::printf("round %zu  score %d  moves %d  seed 0x%016llx\n", i + 1,
+                    r.score, r.moves, static_cast<unsigned long long>(r.seed));
+    }
+}
+
+/* ----------------------------------------------------------------------
+ *  --replay FILE --headless: the recorded session through the same
+ *  scenes as fast as possible, without a window and without drawing
+ * ---------------------------------------------------------------------- */
+static int replayHeadless(InputReplay& in, sf::Font& font, InputBindings& binds,
+                          Settings& set, BoardPool& pool, FrameProfiler& prof)
+{
+    sf::Vector2u size(in.header().width, in.header().height);
+    std::unique_ptr<Scene> scene = makeScene(SceneID::Menu, font, binds, set, pool, size);
+
+    sf::Clock wall;
+    double    played = 0;
+    bool      open   = true;
+    float     dt;
+    sf::Event e;
+    std::uint32_t at;
+    while (open && in.nextFrame(dt)) {
+        prof.beginFrame();
+        while (in.nextEvent(e, at)) {
+            if (e.type == sf::Event::Closed)  open = false;
+            if (e.type == sf::Event::Resized) size = { e.size.width, e.size.height };
+            scene->handleEvent(e);
+        }
+        prof.mark(FrameProfiler::Events);
+
+        scene->update(dt);
+        played += dt;
+        SceneID jump = scene->next();
+        if (jump == SceneID::Exit) open = false;
+        else if (auto next = makeScene(jump, font, binds, set, pool, size)) scene = std::move(next);
+        prof.mark(FrameProfiler::Update);
+        prof.endFrame();
+    }
+
+    float secs = wall.getElapsedTime().asSeconds();
+    FrameProfiler::Stats st = prof.stats(FrameProfiler::CAPACITY);
+    std::printf("replayed %llu frames, %llu events, %.1f s of play in %.3f s (%.0f frames/s)\n",
+                static_cast<unsigned long long>(in.frames()),
+                static_cast<unsigned long long>(in.events()),
+                played, secs, in.frames() / std::max(secs, 1e-6f));
+    std::printf("frame p50 %.3f  p99 %.3f  max %.3f ms (last %zu frames)\n",
+                st.p50, st.p99, st.worst,
+                std::size_t(std::min<std::uint64_t>(in.frames(), FrameProfiler::CAPACITY)));
+    printRounds(set.history);
+    if (in.truncated()) std::fprintf(stderr, "input log is truncated\n");
+    return in.truncated() ? 1 : 0;
+}
+
+/* ----------------------------------------------------------------------
+ *  --render-thread: this thread polls events and updates the scene,
+ *  RenderThread draws and presents. Events are stamped as they are
+ *  taken from the queue, and the queue is read every TICK_MS while
+ *  anything moves, so a release is applied against the clock within a
+ *  millisecond or so of the player letting go, whatever a frame costs.
+ *  Returns with the window closed.
+ * ---------------------------------------------------------------------- */
+static void runThreaded(sf::RenderWindow& app, std::unique_ptr<Scene> scene,
+                        sf::Font& font, InputBindings& binds, Settings& set,
+                        BoardPool& pool, FrameProfiler& prof, InputRecorder& rec,
+                        std::function<void()> firstPresent)
+{
+    using clock = std::chrono::steady_clock;
+    constexpr int TICK_MS = 1;
+
+    sf::Vector2u size = app.getSize();
+    RenderThread rt(app, font, set, prof, std::move(firstPresent));
+    rt.start(scene.get());
+
+    sf::Clock dtClock;
+    bool      open = true;
+    while (open) {
+        rec.beginFrame();
+        float wake = scene->wakeAfter();
+        bool  live = wake == 0.f || set.showProfiler;
+
+        /* idle: sleep until input or the scene's next change; the
+           render thread has nothing to do meanwhile either             */
+        sf::Event         e;
+        bool              got = false;
+        if (!live && !scene->dirty())
+            got = wake == Scene::FOREVER ? app.waitEvent(e) : waitEventFor(app, e, wake);
+        else
+            sf::sleep(sf::milliseconds(TICK_MS));
+
+        /* scenes that draw from a snapshot run without the lock */
+        std::unique_lock<std::mutex> held(rt.mutex(), std::defer_lock);
+        if (!scene->snapshots()) held.lock();
+
+        auto dispatch = [&](const sf::Event& ev) {
+            rec.event(ev);
+            if (ev.type == sf::Event::Closed) open = false;
+            if (ev.type == sf::Event::Resized) size = { ev.size.width, ev.size.height };
+            if (ev.type == sf::Event::Resized || ev.type == sf::Event::GainedFocus)
+                scene->markDirty();
+            scene->handleEvent(ev);
+        };
+        bool              input   = got;
+        clock::time_point arrived = clock::now();    // of the first event taken
+        if (got) dispatch(e);
+        while (app.pollEvent(e)) {
+            if (!input) { arrived = clock::now(); input = true; }
+            dispatch(e);
+        }
+
+        float dt = InputLog::fromMicros(InputLog::toMicros(dtClock.restart().asSeconds()));
+        rec.frame(dt);
+        scene->update(dt);
+
+        SceneID jump = scene->next();
+        if (jump == SceneID::Exit) open = false;
+        else if (jump != SceneID::None) {
+            if (!held.owns_lock()) held.lock();   // the old scene may be on screen
+            if (auto next = makeScene(jump, font, binds, set, pool, size)) {
+                scene = std::move(next);
+                rt.setScene(scene.get());
+            }
+        }
+
+        if (!live && !scene->dirty()) continue;
+        scene->publish();
+        scene->markDrawn();
+        if (held.owns_lock()) held.unlock();
+        if (input) rt.frame(arrived); else rt.frame();
+    }
+
+    rt.stop();
+    app.close();
+}
+
+/* ----------------------------------------------------------------------
+ *  fruit_box_local [--trace FILE] [--record FILE | --replay FILE [--headless]]
+ *                  [--startup-profile] [--render-thread]
+ *    --trace     write the last frames as Chrome trace-event JSON on exit
+ *    --record    write the session's input to FILE (see InputLog.hpp)
+ *    --replay    play FILE back in real time; the window's own input is
+ *                ignored apart from closing it; scores are not saved
+ *    --headless  with --replay: no window, no drawing, as fast as possible
+ *    --startup-profile  print where the time went from process start to
+ *                the first presented frame (stderr)
+ *    --render-thread  draw and present on a thread of their own, so
+ *                input is handled while a frame is drawn (not with
+ *                --replay, which keeps its frames in step with the log)
+ * ---------------------------------------------------------------------- */
+int main(int argc, char** argv) {
+    StartupProfile boot;
+    std::string tracePath, recordPath, replayPath;
+    bool headless = false, startupProfile = false, renderThread = false;
+    for (int i = 1; i < argc; ++i) {
+        if      (!std::strcmp(argv[i], "--trace")  && i + 1 < argc) tracePath  = argv[++i];
+        else if (!std::strcmp(argv[i], "--record") && i + 1 < argc) recordPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--replay") && i + 1 < argc) replayPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--headless")) headless = true;
+        else if (!std::strcmp(argv[i], "--startup-profile")) startupProfile = true;
+        else if (!std::strcmp(argv[i], "--render-thread"))   renderThread = true;
+    }
+
+    InputReplay in;
+    bool replaying = !replayPath.empty();
+    if (replaying && !in.open(replayPath)) {
+        std::cerr << "could not read input log " << replayPath << '\n';
+        return 1;
+    }
+    boot.mark("arguments");
+
+    /* the score file loads while the font, the pool and the window come
+       up; it is needed by the first scene (best scores on the menu)    */
+    using clock = std::chrono::steady_clock;
+    clock::duration         scoresTook{};
+    std::future<ScoreStore> scores;
+    if (!replaying)
+        scores = std::async(std::launch::async, [&scoresTook] {
+            clock::time_point t = clock::now();
+            ScoreStore s(ScoreStore::dataPath());
+            scoresTook = clock::now() - t;
+            return s;
+        });
 
     sf::Font        font = loadFont();
     InputBindings   binds;
-    Settings        set;
+    Settings        set;                 // history stays in memory on replay
+    boot.mark("font");
+
+    std::random_device rd;
+    std::uint64_t entropy = (std::uint64_t(rd()) << 32) | rd();
+    sf::Vector2u  winSize(1024, 768);
+    if (replaying) {
+        const InputLog::Header& h = in.header();
+        entropy          = h.entropy;
+        set.minMoves     = h.minMoves;
+        set.showFPS      = h.showFPS;
+        set.showProfiler = h.showProfiler;
+        set.rules        = { int(h.rows), int(h.cols), int(h.target), int(h.lo), int(h.hi) };
+        winSize          = { h.width, h.height };
+    }
+    BoardPool       pool(entropy, set.minMoves, set.rules);
+    FrameProfiler   prof;
+    boot.mark("board pool");
+
+    if (replaying && headless) {
+        int rc = replayHeadless(in, font, binds, set, pool, prof);
+        if (!tracePath.empty() && !prof.writeTrace(tracePath))
+            std::cerr << "could not write trace to " << tracePath << '\n';
+        return rc;
+    }
+
+    sf::RenderWindow app(sf::VideoMode(winSize.x, winSize.y),
+                         "Fruit Box Local", sf::Style::Default);
+    boot.mark("window");
+
+    /* pacing follows the settings; applied again whenever they change */
+    FramePacer pacer;
+    Pacing     pacing = set.pacing;
+    int        cap    = -1;
+    auto applyPacing = [&] {
+        pacing = set.pacing;
+        cap    = set.frameCap;
+        app.setVerticalSyncEnabled(pacing == Pacing::VSync);
+        pacer.setRate(pacing == Pacing::Limit ? cap : 0);
+    };
+    applyPacing();
+
+    InputRecorder rec;
+    if (!recordPath.empty() &&
+        !rec.open(recordPath, { entropy, set.minMoves, set.showFPS, set.showProfiler,
+                                app.getSize().x, app.getSize().y,
+                                unsigned(set.rules.rows), unsigned(set.rules.cols),
+                                unsigned(set.rules.target), unsigned(set.rules.lo),
+                                unsigned(set.rules.hi) }))
+        std::cerr << "could not write input log " << recordPath << '\n';
+
+    if (scores.valid()) {
+        clock::time_point t = clock::now();
+        set.history = scores.get();
+        boot.background("score file (thread)", scoresTook, clock::now() - t);
+    }
+    boot.mark("score file join");
 
-    std::unique_ptr<Scene> scene = std::make_unique<MenuScene>(font);
+    sf::Vector2u size = app.getSize();     // as the scenes saw it (recorded)
+    std::unique_ptr<Scene> scene = makeScene(SceneID::Menu, font, binds, set, pool, size);
+    bool firstFrame = true;
+    boot.mark("menu scene");
     sf::Clock dtClock;
+    sf::Clock replayClock;
+    double    replayDue = 0;                 // replay time of the last update
+
+    ProfilerOverlay overlay;
+
+    if (renderThread && !replaying)
+        runThreaded(app, std::move(scene), font, binds, set, pool, prof, rec, [&] {
+            boot.mark("first frame presented");
+            if (startupProfile) boot.print(stderr);
+        });
 
     while (app.isOpen()) {
-        float dt = dtClock.restart().asSeconds();
+        prof.beginFrame();
+        rec.beginFrame();
+        if (set.pacing != pacing || set.frameCap != cap) applyPacing();
+        float dt = 0.f;
 
-        sf::Event e;
-        while (app.pollEvent(e)) {
+        auto dispatch = [&](const sf::Event& e) {
+            rec.event(e);
             if (e.type == sf::Event::Closed) app.close();
+            if (e.type == sf::Event::Resized) size = { e.size.width, e.size.height };
+            if (e.type == sf::Event::Resized || e.type == sf::Event::GainedFocus)
+                scene->markDirty();
             scene->handleEvent(e);
+        };
+
+        float wake = scene->wakeAfter();
+        bool  live = wake == 0.f || set.showProfiler;
+        sf::Event e;
+        if (replaying) {
+            /* recorded events at their recorded offsets, then the frame's dt */
+            auto waitUntil = [&](double t) {
+                double ahead = t - replayClock.getElapsedTime().asSeconds();
+                if (ahead > 0) sf::sleep(sf::seconds(float(ahead)));
+            };
+            while (app.pollEvent(e))
+                if (e.type == sf::Event::Closed) app.close();
+            if (!app.isOpen() || !in.nextFrame(dt)) break;
+            std::uint32_t at;
+            while (in.nextEvent(e, at)) {
+                waitUntil(replayDue + at / 1e6);
+                if (e.type == sf::Event::Resized) app.setSize({ e.size.width, e.size.height });
+                dispatch(e);
+            }
+            replayDue += dt;
+            waitUntil(replayDue);
+        } else {
+            /* idle: nothing changed since the last frame, so sleep until
+               input arrives or the scene's next scheduled change        */
+            if (!live && !scene->dirty()) {
+                if (wake == Scene::FOREVER ? app.waitEvent(e)
+                                           : waitEventFor(app, e, wake))
+                { prof.woke(); dispatch(e); }
+            } else {
+                pacer.waitToSample();        // Pacing::Limit: read input late
+            }
+            bool any = false;
+            while (app.pollEvent(e)) { any = true; dispatch(e); }
+            prof.polled(any);
+
+            /* dt spans sample to sample, quantised as a replay sees it */
+            dt = InputLog::fromMicros(InputLog::toMicros(dtClock.restart().asSeconds()));
+            rec.frame(dt);
         }
+        prof.mark(FrameProfiler::Events);
+
         scene->update(dt);
 
         SceneID jump = scene->next();
-        if (jump != SceneID::None) {
-            switch (jump) {
-                case SceneID::Menu:
-                    scene = std::make_unique<MenuScene>(font); break;
-                case SceneID::Config:
-                    scene = std::make_unique<ConfigScene>(font, binds, set); break;
-                case SceneID::Game:
-                    scene = std::make_unique<GameScene>(font, binds, set, app.getSize()); break;
-                case SceneID::Exit:
-                    app.close(); break;
-                default: break;
-            }
-        }
+        if (jump == SceneID::Exit) app.close();
+        else if (auto next = makeScene(jump, font, binds, set, pool, size))
+            scene = std::move(next);
+
+        prof.mark(FrameProfiler::Update);
+
+        /* unchanged frame: keep what is on screen, skip draw + present */
+        if (!live && !scene->dirty()) { prof.endFrame(); continue; }
 
+        scene->publish();
         app.clear(sf::Color::Black);
         scene->draw(app);
-        app.display();
+        if (set.showProfiler) overlay.draw(app, font, prof);
+        scene->markDrawn();
+        prof.mark(FrameProfiler::Draw);
+
+        app.display();                       // includes the vsync wait
+        prof.mark(FrameProfiler::Present);
+        pacer.presented();
+        prof.endFrame();
+
+        if (firstFrame) {
+            firstFrame = false;
+            boot.mark("first frame presented");
+            if (startupProfile) boot.print(stderr);
+        }
     }
+
+    if (replaying) printRounds(set.history);
+    if (!tracePath.empty() && !prof.writeTrace(tracePath))
+        std::cerr << "could not write trace to " << tracePath << '\n';
 }